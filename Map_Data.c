@@ -0,0 +1,135 @@
+#include "Map_Data.h"
+#include "raycast-core/map_grid.h"
+#include "render/sprite.h"
+
+// filled in by config_map
+volatile int MAP_DATA[MAP_SIZE_X][MAP_SIZE_Y];
+
+// MAP_GRID's storage while it holds the snapshot of MAP_DATA
+unsigned int SNAPSHOT_STORAGE[MAP_STORAGE_BOUND(MAP_SIZE_X, MAP_SIZE_Y) / sizeof(unsigned int)];
+
+void snapshot_map() {
+	// lay out the grid the first time, or when MAP_GRID was pointed at another map
+	if ((void*)MAP_GRID.levels[0].bits != (void*)SNAPSHOT_STORAGE) {
+		map_init(&MAP_GRID, MAP_SIZE_X, MAP_SIZE_Y, SNAPSHOT_STORAGE);
+	}
+	map_level* cells = &MAP_GRID.levels[0];
+
+	// the pyramid is only rebuilt, and the map only gets a new generation, when MAP_DATA changed
+	bool changed = false;
+	int x, y, bit;
+	for (x = 0; x < MAP_SIZE_X; x++) {
+		for (y = 0; y < MAP_SIZE_Y; y += 32) {
+			// one volatile load per cell, then build each occupancy word in a register
+			unsigned int word = 0;
+			for (bit = 0; bit < 32 && y + bit < MAP_SIZE_Y; bit++) {
+				int tile = MAP_DATA[x][y + bit];
+				if (tile < 0) tile = 0;
+				if (tile > 255) tile = 255;
+
+				unsigned char* tile_type = &MAP_GRID.tile_type[map_tile_index(&MAP_GRID, x, y + bit)];
+				if (*tile_type != tile) {
+					*tile_type = tile;
+					changed = true;
+				}
+				if (tile != 0) word |= 1u << bit;
+			}
+			unsigned int* bits = &cells->bits[x * cells->words_y + (y >> 5)];
+			if (*bits != word) {
+				*bits = word;
+				changed = true;
+			}
+		}
+	}
+	if (changed) {
+		map_build_pyramid(&MAP_GRID);
+	}
+}
+
+void config_map() {
+
+	// initializes the map with a small maze
+	// map.PNG is an image of this map
+
+	int i, j;
+	for (i = 0; i < MAP_SIZE_X; i++) {
+		for (j = 0; j < MAP_SIZE_Y; j++) {
+			MAP_DATA[i][j] = 0;
+		}
+	}
+
+	MAP_DATA[0][0] = 1;
+	MAP_DATA[1][0] = 1;
+	MAP_DATA[2][0] = 1;
+	MAP_DATA[3][0] = 1;
+	MAP_DATA[4][0] = 1;
+	MAP_DATA[5][0] = 1;
+	MAP_DATA[6][0] = 1;
+	MAP_DATA[7][0] = 1;
+	MAP_DATA[11][0] = 1;
+	MAP_DATA[14][0] = 1;
+
+	MAP_DATA[7][1] = 1;
+	MAP_DATA[11][1] = 1;
+	MAP_DATA[14][1] = 1;
+
+	MAP_DATA[0][2] = 1;
+	MAP_DATA[1][2] = 1;
+	MAP_DATA[2][2] = 1;
+	MAP_DATA[3][2] = 1;
+	MAP_DATA[4][2] = 1;
+	MAP_DATA[5][2] = 1;
+	MAP_DATA[7][2] = 1;
+	MAP_DATA[11][2] = 1;
+	MAP_DATA[14][2] = 1;
+
+	MAP_DATA[5][3] = 1;
+	MAP_DATA[7][3] = 1;
+	MAP_DATA[11][3] = 1;
+	MAP_DATA[14][3] = 1;
+
+	MAP_DATA[5][4] = 1;
+	MAP_DATA[7][4] = 1;
+	MAP_DATA[11][4] = 1;
+	MAP_DATA[14][4] = 1;
+
+	MAP_DATA[5][5] = 1;
+	MAP_DATA[7][5] = 1;
+	MAP_DATA[11][5] = 1;
+	MAP_DATA[14][5] = 1;
+
+	MAP_DATA[5][6] = 1;
+	MAP_DATA[7][6] = 1;
+	MAP_DATA[8][6] = 1;
+	MAP_DATA[11][6] = 1;
+	MAP_DATA[14][6] = 1;
+
+	MAP_DATA[0][9] = 1;
+	MAP_DATA[1][9] = 1;
+	MAP_DATA[2][9] = 1;
+	MAP_DATA[3][9] = 1;
+	MAP_DATA[4][9] = 1;
+	MAP_DATA[5][9] = 1;
+	MAP_DATA[6][9] = 1;
+	MAP_DATA[7][9] = 1;
+	MAP_DATA[8][9] = 1;
+	MAP_DATA[9][9] = 1;
+	MAP_DATA[10][9] = 1;
+	MAP_DATA[11][9] = 1;
+	MAP_DATA[12][9] = 1;
+	MAP_DATA[13][9] = 1;
+}
+
+void config_sprites() {
+	clear_sprites();
+
+	// sprites stand in the middle of a cell, cell * 64 + 32 in unit coordinates
+	add_sprite(3 * 64 + 32, 1 * 64 + 32, SPRITE_PICKUP);
+	add_sprite(9 * 64 + 32, 4 * 64 + 32, SPRITE_PICKUP);
+	add_sprite(12 * 64 + 32, 12 * 64 + 32, SPRITE_PICKUP);
+	add_sprite(20 * 64 + 32, 5 * 64 + 32, SPRITE_PICKUP);
+
+	add_sprite(9 * 64 + 32, 2 * 64 + 32, SPRITE_ENEMY);
+	add_sprite(4 * 64 + 32, 6 * 64 + 32, SPRITE_ENEMY);
+	add_sprite(16 * 64 + 32, 10 * 64 + 32, SPRITE_ENEMY);
+}
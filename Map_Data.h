@@ -4,6 +4,21 @@
 #define MAP_SIZE_X 64
 #define MAP_SIZE_Y 64
 
+// the editable map, indexed [x][y]. 0 is an open cell, anything else is a wall of that tile type.
+// It can change at any time (from an ISR, say), so the ray casters never read it directly, see snapshot_map
 extern volatile int MAP_DATA[MAP_SIZE_X][MAP_SIZE_Y];
- 
-#endif
\ No newline at end of file
+
+// initializes MAP_DATA with a small maze, map.PNG is an image of this map
+void config_map();
+
+// places pickups and enemies (see render/sprite.h) in the open cells of config_map's maze
+void config_sprites();
+
+// copies MAP_DATA into MAP_GRID (see raycast-core/map_grid.h), the packed, non-volatile map the ray casters
+// trace against, so the whole frame sees the same map. The occupancy bitmap is all the DDA reads per step,
+// at 512 bytes for the 64x64 map it stays in L1. Tile types are clamped to 0 - 255.
+// draw_frame calls this before casting unless a map file is loaded, anything else that casts rays must call it after changing MAP_DATA.
+// The pyramid is only rebuilt when MAP_DATA changed since the last snapshot, see map_grid.generation
+void snapshot_map();
+
+#endif
@@ -53,6 +53,7 @@
 /* ARM A9 MPCORE devices */
 #define   PERIPH_BASE         0xFFFEC000    // base address of peripheral devices
 #define   MPCORE_PRIV_TIMER   0xFFFEC600    // PERIPH_BASE + 0x0600
+#define   MPCORE_GLOBAL_TIMER 0xFFFEC200    // PERIPH_BASE + 0x0200
 
 /* Interrupt controller (GIC) CPU interface(s) */
 #define MPCORE_GIC_CPUIF      0xFFFEC100    // PERIPH_BASE + 0x100
@@ -0,0 +1,86 @@
+#ifndef BACKEND_H
+#define BACKEND_H
+
+#include <stdbool.h>
+
+// The backend owns the frame buffers and the KEY inputs. Exactly one backend is linked in:
+// de1soc.c on the board, host.c when building on Linux with HOST_BACKEND defined.
+
+// number of pixels between the start of two rows in the frame buffer.
+// the DE1-SoC pixel buffer uses 1024 byte rows (the y << 10 addressing), the host buffers match it
+#define FRAME_BUFFER_STRIDE 512
+
+// the frame buffer currently being drawn to, this is the back buffer once backend_init returns
+extern short int* FRAME_BUFFER_ADDR;
+
+// sets up the front and back buffers and points FRAME_BUFFER_ADDR to the back buffer
+void backend_init(void);
+
+// returns the state of KEY0-KEY3 now, in the same format as the KEY data register
+int backend_read_keys(void);
+
+// presents the back buffer (waits for V-Sync on the board), then points FRAME_BUFFER_ADDR to the new back buffer
+void backend_swap_buffers(void);
+
+// true when the main loop should stop. Never true on the board
+bool backend_should_quit(void);
+
+// points MAP_GRID at a prebuilt map file (see raycast-core/map_file.h) without copying it, if there is one.
+// The host maps the file named by RAYCAST_MAP, the board uses the blob in map_blob.s when built with LINKED_MAP.
+// Returns false if there is no map to load, the caller then builds MAP_DATA
+bool backend_load_map(void);
+
+// lets the backend keep the tile chunks around the player (in unit coordinates) in memory and drop the rest.
+// Does nothing on the board, where the whole map is in SDRAM
+void backend_stream_map(int player_x, int player_y);
+
+// ---- input (see input.h) ----
+
+// starts feeding KEY changes into KEY_EVENTS. When built with KEY_INTERRUPTS the board enables the KEY
+// interrupts, so pushbutton_ISR pushes them. The host starts a thread standing in for the interrupt, which
+// pushes the changes of the key script
+void backend_start_input(void);
+
+// called by the main loop once a frame before draining KEY_EVENTS. Without KEY_INTERRUPTS the board reads the
+// KEYs here and pushes them if they changed. The host waits until its interrupt thread has pushed every
+// change up to backend_time_us, so replays don't depend on how the threads are scheduled
+void backend_poll_input(void);
+
+// the time in microseconds, wrapping around. The board counts it with the A9 global timer. The host uses the
+// monotonic clock, or SIM_TICK_US per presented frame while a key script plays, so a key script replays the
+// same whatever the frame rate
+unsigned int backend_time_us(void);
+
+// the time in microseconds as backend_time_us, but always the real time, even while a key script plays. For
+// measuring how long frames take
+unsigned int backend_wall_time_us(void);
+
+// the most workers backend_parallel_for runs. Work split between more of them has to be clamped to this first
+#define BACKEND_MAX_WORKERS 64
+
+// runs job(worker, arg) for every worker from 0 to worker_count - 1 in parallel, and returns once all of them
+// have finished. The host runs them on a pool of threads. The board runs them one after another on CPU0,
+// since CPU1 is never released from reset. worker_count is clamped to BACKEND_MAX_WORKERS, see backend_workers
+void backend_parallel_for(int worker_count, void (*job)(int worker, void* arg), void* arg);
+
+// the number of workers backend_parallel_for runs when asked for worker_count
+static inline int backend_workers(int worker_count) {
+	return (worker_count > BACKEND_MAX_WORKERS) ? BACKEND_MAX_WORKERS : worker_count;
+}
+
+// ---- profiling (see profile/profile.h) ----
+
+// starts the clock profiling reads. The board uses the A9 private timer, or the PMU cycle counter when built
+// with PROFILE_PMU. The host uses clock_gettime, or the CPU cycle counter through perf_event when built with PROFILE_PERF
+void backend_profile_clock_init(void);
+
+// the profiling clock, wrapping around. Only differences of it mean anything
+unsigned int backend_profile_ticks(void);
+
+// profiling clock ticks per second, or 0 if the ticks are CPU cycles at an unknown rate
+unsigned int backend_profile_tick_rate(void);
+
+// writes text to the JTAG UART on the board, to stdout on the host
+void backend_log(const char* text);
+
+#endif // BACKEND_H
@@ -0,0 +1,191 @@
+#include "backend.h"
+#include "pixel_buffer.h"
+#include "../address_map_arm.h"
+#include "../raycast-core/raycast.h"
+#include "../raycast-core/map_file.h"
+#include "../input.h"
+#include "../interrupts/key_interrupt_setup.h"
+
+#ifdef LINKED_MAP
+// included in map_blob.s. Modify the path there to the map file as required
+extern const unsigned char MAP_BLOB[];
+extern const unsigned int MAP_BLOB_SIZE;
+#endif
+
+short int* FRAME_BUFFER_ADDR; // the address of the frame buffer, this should be the back buffer for complex animations
+
+volatile int * FRAME_BUFFER_CTRL_PTR; // frame buffer controller
+
+// with TRIPLE_BUFFER, the three buffers are in SDRAM one after another, each SCREEN_SIZE_Y rows of 1024 bytes
+#define SDRAM_FRAME_BUFFER_BYTES 0x40000
+
+static void clear_buffer(short int* buffer);
+
+void backend_init(void) {
+
+	FRAME_BUFFER_CTRL_PTR = (int *)PIXEL_BUF_CTRL_BASE;
+	short int* buffers[PRESENT_BUFFERS];
+
+#ifdef TRIPLE_BUFFER
+	int i;
+	for (i = 0; i < PRESENT_BUFFERS; i++) {
+		buffers[i] = (short int *)(SDRAM_BASE + i * SDRAM_FRAME_BUFFER_BYTES);
+		clear_buffer(buffers[i]);
+	}
+#else
+	// ------------------- clear the front frame buffer -----------------
+
+	/* Read location of the front frame buffer from the pixel buffer controller */
+	buffers[0] = (short int *)*FRAME_BUFFER_CTRL_PTR;
+	clear_buffer(buffers[0]);
+
+	// ------------------ initialize the back frame buffer -------------
+
+	// initializes the back buffer to the start of SDRAM memory
+	buffers[1] = (short int *)SDRAM_BASE;
+#endif
+
+	// we draw to and clear from the back buffer now!
+	FRAME_BUFFER_ADDR = present_init(buffers, PRESENT_BUFFERS);
+}
+
+int backend_read_keys(void) {
+	return *(volatile int *)KEY_BASE;
+}
+
+uintptr_t pixel_buf_read(int reg) {
+	return (unsigned int)FRAME_BUFFER_CTRL_PTR[reg];
+}
+
+void pixel_buf_write(int reg, uintptr_t value) {
+	FRAME_BUFFER_CTRL_PTR[reg] = value;
+}
+
+// asks for a swap at the next V-Sync (on most displays every 1/60th of a second), see backend/pixel_buffer.h.
+// With two buffers this waits for the swap, with TRIPLE_BUFFER only for the swap of the frame before
+void backend_swap_buffers(void) {
+	FRAME_BUFFER_ADDR = present_frame();
+}
+
+// ---- input ----
+
+// the A9 global timer counts up at the 200 MHz peripheral clock divided by its prescaler plus one
+#define GLOBAL_TIMER_PRESCALER (200 - 1)
+
+// the KEYs backend_poll_input read last
+int polled_key_value = 0;
+
+void backend_start_input(void) {
+	volatile int* timer = (int*)MPCORE_GLOBAL_TIMER;
+	// control: enabled, counting microseconds
+	*(timer + 2) = (GLOBAL_TIMER_PRESCALER << 8) | 0x1;
+
+#ifdef KEY_INTERRUPTS
+	config_key_interrupts();
+#endif
+}
+
+void backend_poll_input(void) {
+#ifndef KEY_INTERRUPTS
+	int key_value = backend_read_keys();
+	if (key_value != polled_key_value) {
+		key_event event = { backend_time_us(), key_value };
+		key_event_push_latest(&KEY_EVENTS, event);
+		polled_key_value = key_value;
+	}
+#endif
+}
+
+unsigned int backend_time_us(void) {
+	// the low word of the 64 bit counter, which wraps around every 71 minutes
+	return *(volatile unsigned int*)MPCORE_GLOBAL_TIMER;
+}
+
+unsigned int backend_wall_time_us(void) {
+	return backend_time_us();
+}
+
+bool backend_should_quit(void) {
+	return false;
+}
+
+bool backend_load_map(void) {
+#ifdef LINKED_MAP
+	return map_attach(&MAP_GRID, MAP_BLOB, MAP_BLOB_SIZE);
+#else
+	return false;
+#endif
+}
+
+void backend_stream_map(int player_x, int player_y) {
+}
+
+void backend_parallel_for(int worker_count, void (*job)(int worker, void* arg), void* arg) {
+	int worker;
+	worker_count = backend_workers(worker_count);
+	for (worker = 0; worker < worker_count; worker++) {
+		job(worker, arg);
+	}
+}
+
+// draws black over every pixel of the buffer
+static void clear_buffer(short int* buffer) {
+	int x, y;
+	for (y = 0; y < SCREEN_SIZE_Y; y++) {
+		for (x = 0; x < SCREEN_SIZE_X; x++) {
+			buffer[y * FRAME_BUFFER_STRIDE + x] = 0x0000;
+		}
+	}
+}
+
+// ---- profiling clock ----
+
+// the A9 private timer counts down from its load value at the 200 MHz peripheral clock
+#define PRIVATE_TIMER_RATE 200000000
+// the PMU cycle counter counts CPU cycles
+#define CPU_CLOCK_RATE 800000000
+
+void backend_profile_clock_init(void) {
+#ifdef PROFILE_PMU
+	// PMCR: enable the counters and reset the cycle counter, then PMCNTENSET: enable the cycle counter
+	unsigned int pmcr;
+	asm volatile("mrc p15, 0, %0, c9, c12, 0" : "=r"(pmcr));
+	asm volatile("mcr p15, 0, %0, c9, c12, 0" :: "r"(pmcr | 0x5));
+	asm volatile("mcr p15, 0, %0, c9, c12, 1" :: "r"(0x80000000));
+#else
+	volatile int* timer = (int*)MPCORE_PRIV_TIMER;
+	// load, then control: enable with auto reload and no prescaler, so it wraps from 0 back to 0xFFFFFFFF
+	*timer = 0xFFFFFFFF;
+	*(timer + 2) = 0x3;
+#endif
+}
+
+unsigned int backend_profile_ticks(void) {
+#ifdef PROFILE_PMU
+	unsigned int cycles;
+	asm volatile("mrc p15, 0, %0, c9, c13, 0" : "=r"(cycles));
+	return cycles;
+#else
+	// the timer counts down, so count up from its complement
+	return ~*(volatile unsigned int*)(MPCORE_PRIV_TIMER + 4);
+#endif
+}
+
+unsigned int backend_profile_tick_rate(void) {
+#ifdef PROFILE_PMU
+	return CPU_CLOCK_RATE;
+#else
+	return PRIVATE_TIMER_RATE;
+#endif
+}
+
+void backend_log(const char* text) {
+	volatile int* jtag_uart = (int*)JTAG_UART_BASE;
+	for (; *text != '\0'; text++) {
+		// only write when there is space in the write FIFO (the upper half of the control register), so
+		// nothing waits on a UART nobody is reading
+		if ((*(jtag_uart + 1) & 0xFFFF0000) != 0) {
+			*jtag_uart = *text;
+		}
+	}
+}
@@ -0,0 +1,570 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <limits.h>
+#include <sched.h>
+#ifdef PROFILE_PERF
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "backend.h"
+#include "host.h"
+#include "pixel_buffer.h"
+#include "../raycast-core/raycast.h"
+#include "../raycast-core/map_file.h"
+#include "../input.h"
+
+#define MAX_KEY_SCRIPT_STEPS 1024
+// chunks of tile types kept in memory on each side of the player's chunk
+#define STREAM_RADIUS 2
+
+// one step of a key script: hold key_value for frame_count frames
+typedef struct key_script_step {
+	int key_value;
+	int frame_count;
+} key_script_step;
+
+short int* FRAME_BUFFER_ADDR;
+
+// in-memory RGB565 buffers standing in for the frame buffers in SDRAM, PRESENT_BUFFERS of them unless
+// host_set_frame_buffers says otherwise
+short int HOST_BUFFERS[PRESENT_MAX_BUFFERS][SCREEN_SIZE_Y * FRAME_BUFFER_STRIDE];
+int host_buffer_count = PRESENT_BUFFERS;
+// the buffer presented last, it may still be waiting for V-Sync
+const short int* presented_buffer = NULL;
+
+key_script_step key_script[MAX_KEY_SCRIPT_STEPS];
+int key_script_length = 0;
+bool key_script_loaded = false;
+
+const char* frame_dump_pattern = NULL;
+int frame_limit = 1;
+int frame_count = 0;
+
+// ------------------------------------ worker thread pool ------------------------------------
+
+// The calling thread runs worker 0 of backend_parallel_for, pool threads run the others. Threads are started
+// the first time a job needs them and then wait for the next job, since starting threads every frame would
+// cost more than a frame's worth of columns
+pthread_t pool_threads[BACKEND_MAX_WORKERS];
+int pool_thread_count = 0;
+
+pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t pool_job_ready = PTHREAD_COND_INITIALIZER;
+pthread_cond_t pool_job_done = PTHREAD_COND_INITIALIZER;
+
+// the current job. job_generation counts jobs, so a pool thread can tell a new job from the one it already ran
+void (*pool_job)(int worker, void* arg);
+void* pool_job_arg;
+int pool_worker_count = 0;
+int pool_job_generation = 0;
+int pool_workers_remaining = 0;
+
+void* pool_thread_main(void* arg);
+
+// the mapped map file, and the chunk the player was in when the chunks were last paged
+unsigned char* map_file_data = NULL;
+size_t map_file_size = 0;
+int stream_chunk_x = -1, stream_chunk_y = -1;
+
+void page_chunks(int chunk_x, int first_y, int last_y, bool keep);
+
+// the pixel buffer controller stand-in, see below
+uintptr_t pixel_buf_registers[4];
+long long vsync_period_ns = 0;
+long long vsync_start_ns = 0;
+long long swap_due_ns = 0;
+
+long long monotonic_ns(void);
+
+// the thread standing in for pushbutton_ISR, and the first frame it hasn't pushed the KEY changes of yet
+pthread_t input_thread;
+bool input_thread_started = false;
+int input_pushed_frames = 0;
+long long input_start_ns = 0;
+
+void backend_init(void) {
+
+	memset(HOST_BUFFERS, 0, sizeof(HOST_BUFFERS));
+	memset(pixel_buf_registers, 0, sizeof(pixel_buf_registers));
+	frame_count = 0;
+	input_start_ns = monotonic_ns();
+
+	const char* setting = getenv("RAYCAST_VSYNC");
+	if (setting != NULL) {
+		host_set_vsync(atoi(setting));
+	}
+	setting = getenv("RAYCAST_BUFFERS");
+	if (setting != NULL && !host_set_frame_buffers(atoi(setting))) {
+		fprintf(stderr, "raycast: RAYCAST_BUFFERS must be 2 or 3\n");
+	}
+	// we draw to the back buffer
+	host_set_frame_buffers(host_buffer_count);
+
+	setting = getenv("RAYCAST_KEYS");
+	if (setting != NULL && !host_load_key_script(setting)) {
+		fprintf(stderr, "raycast: could not read key script %s\n", setting);
+	}
+	setting = getenv("RAYCAST_DUMP");
+	if (setting != NULL) {
+		host_set_frame_dump(setting);
+	}
+	setting = getenv("RAYCAST_FRAMES");
+	if (setting != NULL) {
+		host_set_frame_limit(atoi(setting));
+	}
+}
+
+int backend_read_keys(void) {
+	// find the script step this frame falls in
+	int i, frames_before = 0;
+	for (i = 0; i < key_script_length; i++) {
+		frames_before += key_script[i].frame_count;
+		if (frame_count < frames_before) {
+			return key_script[i].key_value;
+		}
+	}
+	return 0;
+}
+
+void backend_swap_buffers(void) {
+	presented_buffer = FRAME_BUFFER_ADDR;
+	FRAME_BUFFER_ADDR = present_frame();
+
+	if (frame_dump_pattern != NULL) {
+		char path[256];
+		snprintf(path, sizeof(path), frame_dump_pattern, frame_count);
+		if (!host_write_ppm(path, host_front_buffer())) {
+			fprintf(stderr, "raycast: could not write frame %s\n", path);
+		}
+	}
+	frame_count++;
+}
+
+bool backend_should_quit(void) {
+	if (key_script_loaded) {
+		return frame_count >= host_key_script_frames();
+	}
+	return frame_count >= frame_limit;
+}
+
+int host_key_script_frames(void) {
+	int i, total_frames = 0;
+	for (i = 0; i < key_script_length; i++) {
+		total_frames += key_script[i].frame_count;
+	}
+	return total_frames;
+}
+
+// ------------------------------------ KEY interrupt stand-in ------------------------------------
+
+// pushes the change of every step of the key script into KEY_EVENTS, timestamped with the frame it starts in,
+// the way pushbutton_ISR pushes the KEYs on the board. Unlike the ISR it waits for room instead of writing over
+// the overflow, so a replay sees every step
+void* input_thread_main(void* arg) {
+	int i, frame = 0;
+	for (i = 0; i < key_script_length; i++) {
+		key_event event = { (unsigned int)frame * SIM_TICK_US, key_script[i].key_value };
+		while (!key_event_push(&KEY_EVENTS, event)) {
+			sched_yield();
+		}
+		frame += key_script[i].frame_count;
+		__atomic_store_n(&input_pushed_frames, frame, __ATOMIC_RELEASE);
+	}
+	__atomic_store_n(&input_pushed_frames, INT_MAX, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+void backend_start_input(void) {
+	key_event_queue_init(&KEY_EVENTS);
+	if (!key_script_loaded || input_thread_started) {
+		return;
+	}
+	input_pushed_frames = 0;
+	if (pthread_create(&input_thread, NULL, input_thread_main, NULL) != 0) {
+		fprintf(stderr, "raycast: could not start the KEY interrupt thread\n");
+		return;
+	}
+	pthread_detach(input_thread);
+	input_thread_started = true;
+}
+
+void backend_poll_input(void) {
+	// the changes up to this frame would have interrupted by now on the board
+	if (input_thread_started) {
+		while (__atomic_load_n(&input_pushed_frames, __ATOMIC_ACQUIRE) <= frame_count) {
+			sched_yield();
+		}
+	}
+}
+
+unsigned int backend_time_us(void) {
+	if (key_script_loaded) {
+		return (unsigned int)frame_count * SIM_TICK_US;
+	}
+	return backend_wall_time_us();
+}
+
+unsigned int backend_wall_time_us(void) {
+	return (unsigned int)((monotonic_ns() - input_start_ns) / 1000);
+}
+
+// ------------------------------------ pixel buffer controller stand-in ------------------------------------
+
+// The registers of the pixel buffer controller (see backend/pixel_buffer.h), holding pointers to HOST_BUFFERS.
+// A swap asked for happens at the next V-Sync, which comes every vsync_period_ns from host_set_vsync, the
+// first time the status register is read at or after it. With no refresh rate (the default) swaps happen at
+// once, so the benchmarks aren't held to a refresh rate
+
+long long monotonic_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+uintptr_t pixel_buf_read(int reg) {
+	if (reg == PIXEL_BUF_STATUS && (pixel_buf_registers[PIXEL_BUF_STATUS] & PIXEL_BUF_SWAP_PENDING) != 0 &&
+		(vsync_period_ns == 0 || monotonic_ns() >= swap_due_ns)) {
+		uintptr_t front = pixel_buf_registers[PIXEL_BUF_FRONT];
+		pixel_buf_registers[PIXEL_BUF_FRONT] = pixel_buf_registers[PIXEL_BUF_BACK];
+		pixel_buf_registers[PIXEL_BUF_BACK] = front;
+		pixel_buf_registers[PIXEL_BUF_STATUS] &= ~PIXEL_BUF_SWAP_PENDING;
+	}
+	return pixel_buf_registers[reg];
+}
+
+void pixel_buf_write(int reg, uintptr_t value) {
+	if (reg == PIXEL_BUF_FRONT) {
+		// writing the front buffer register asks for a swap, due at the next V-Sync
+		pixel_buf_registers[PIXEL_BUF_STATUS] |= PIXEL_BUF_SWAP_PENDING;
+		if (vsync_period_ns != 0) {
+			long long since_start = monotonic_ns() - vsync_start_ns;
+			swap_due_ns = vsync_start_ns + (since_start / vsync_period_ns + 1) * vsync_period_ns;
+		}
+		return;
+	}
+	pixel_buf_registers[reg] = value;
+}
+
+void host_set_vsync(int refresh_hz) {
+	vsync_period_ns = (refresh_hz > 0) ? 1000000000LL / refresh_hz : 0;
+	vsync_start_ns = monotonic_ns();
+}
+
+bool host_set_frame_buffers(int count) {
+	if (count < 2 || count > PRESENT_MAX_BUFFERS) {
+		return false;
+	}
+	host_buffer_count = count;
+	short int* buffers[PRESENT_MAX_BUFFERS];
+	int i;
+	for (i = 0; i < count; i++) {
+		buffers[i] = HOST_BUFFERS[i];
+	}
+	FRAME_BUFFER_ADDR = present_init(buffers, count);
+	presented_buffer = NULL;
+	return true;
+}
+
+// ------------------------------------ map streaming ------------------------------------
+
+// The map file is mapped read-only, so nothing is read until a ray touches it. The bit planes are small and
+// read by every ray, so they stay. Tile type chunks are only read where rays stop, so only the ones within
+// STREAM_RADIUS chunks of the player are used (see map_grid.stream_first_x). They are paged in ahead of time,
+// and the others are unmapped from this process whenever the player moves to another chunk
+
+bool backend_load_map(void) {
+	const char* path = getenv("RAYCAST_MAP");
+	if (path == NULL) {
+		return false;
+	}
+	if (!host_open_map(path)) {
+		fprintf(stderr, "raycast: could not load map %s\n", path);
+		return false;
+	}
+	return true;
+}
+
+void backend_stream_map(int player_x, int player_y) {
+	if (map_file_data == NULL || MAP_GRID.tile_type < map_file_data || MAP_GRID.tile_type >= map_file_data + map_file_size) {
+		// MAP_GRID isn't the mapped file
+		return;
+	}
+
+	int chunk_x = (player_x >> 6) >> MAP_CHUNK_SHIFT, chunk_y = (player_y >> 6) >> MAP_CHUNK_SHIFT;
+	if (chunk_x == stream_chunk_x && chunk_y == stream_chunk_y) {
+		return;
+	}
+	stream_chunk_x = chunk_x;
+	stream_chunk_y = chunk_y;
+
+	// chunks are stored x major, so each x column of chunks is one range of memory, and the chunks to keep
+	// are the middle 2 * STREAM_RADIUS + 1 of them
+	int first_y = chunk_y - STREAM_RADIUS, last_y = chunk_y + STREAM_RADIUS + 1;
+	if (first_y < 0) first_y = 0;
+	if (last_y > MAP_GRID.chunks_y) last_y = MAP_GRID.chunks_y;
+	if (first_y > last_y) first_y = last_y;
+
+	MAP_GRID.stream_first_x = chunk_x - STREAM_RADIUS;
+	MAP_GRID.stream_last_x = chunk_x + STREAM_RADIUS + 1;
+	MAP_GRID.stream_first_y = first_y;
+	MAP_GRID.stream_last_y = last_y;
+	map_changed(&MAP_GRID);
+
+	int x;
+	for (x = 0; x < MAP_GRID.chunks_x; x++) {
+		if (abs(x - chunk_x) > STREAM_RADIUS) {
+			page_chunks(x, 0, MAP_GRID.chunks_y, false);
+			continue;
+		}
+		page_chunks(x, 0, first_y, false);
+		page_chunks(x, first_y, last_y, true);
+		page_chunks(x, last_y, MAP_GRID.chunks_y, false);
+	}
+}
+
+// pages in, or drops, chunks first_y to last_y - 1 of x column chunk_x. This does nothing on systems with
+// pages bigger than a chunk, where the chunks aren't page aligned
+void page_chunks(int chunk_x, int first_y, int last_y, bool keep) {
+	if (first_y >= last_y) {
+		return;
+	}
+	size_t offset = ((size_t)chunk_x * MAP_GRID.chunks_y + first_y) * MAP_CHUNK_BYTES;
+	size_t length = (size_t)(last_y - first_y) * MAP_CHUNK_BYTES;
+	madvise(MAP_GRID.tile_type + offset, length, keep ? MADV_WILLNEED : MADV_DONTNEED);
+}
+
+bool host_open_map(const char* path) {
+	int file = open(path, O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size == 0) {
+		close(file);
+		return false;
+	}
+	void* data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	// the mapping stays valid after the file is closed
+	close(file);
+	if (data == MAP_FAILED) {
+		return false;
+	}
+	if (!map_attach(&MAP_GRID, data, status.st_size)) {
+		munmap(data, status.st_size);
+		return false;
+	}
+
+	if (map_file_data != NULL) {
+		munmap(map_file_data, map_file_size);
+	}
+	map_file_data = data;
+	map_file_size = status.st_size;
+	stream_chunk_x = stream_chunk_y = -1;
+	return true;
+}
+
+size_t host_resident_map_bytes(void) {
+	if (map_file_data == NULL) {
+		return 0;
+	}
+
+	// find the mapping in /proc/self/smaps, its Rss line follows a few lines after
+	FILE* smaps = fopen("/proc/self/smaps", "r");
+	if (smaps == NULL) {
+		return 0;
+	}
+	char line[256];
+	bool in_mapping = false;
+	size_t resident_kb = 0;
+	while (fgets(line, sizeof(line), smaps) != NULL) {
+		// mappings start with their address range, their fields with a name
+		unsigned long start, end;
+		if (sscanf(line, "%lx-%lx ", &start, &end) == 2) {
+			in_mapping = (start == (unsigned long)map_file_data);
+		} else if (in_mapping && sscanf(line, "Rss: %zu kB", &resident_kb) == 1) {
+			break;
+		}
+	}
+	fclose(smaps);
+	return resident_kb * 1024;
+}
+
+void backend_parallel_for(int worker_count, void (*job)(int worker, void* arg), void* arg) {
+	worker_count = backend_workers(worker_count);
+	if (worker_count <= 1) {
+		job(0, arg);
+		return;
+	}
+
+	pthread_mutex_lock(&pool_lock);
+	// pool thread i runs worker i + 1
+	while (pool_thread_count < worker_count - 1) {
+		pthread_create(&pool_threads[pool_thread_count], NULL, pool_thread_main, (void*)(long)(pool_thread_count + 1));
+		pool_thread_count++;
+	}
+	pool_job = job;
+	pool_job_arg = arg;
+	pool_worker_count = worker_count;
+	pool_workers_remaining = worker_count - 1;
+	pool_job_generation++;
+	pthread_cond_broadcast(&pool_job_ready);
+	pthread_mutex_unlock(&pool_lock);
+
+	job(0, arg);
+
+	pthread_mutex_lock(&pool_lock);
+	while (pool_workers_remaining > 0) {
+		pthread_cond_wait(&pool_job_done, &pool_lock);
+	}
+	pthread_mutex_unlock(&pool_lock);
+}
+
+void* pool_thread_main(void* arg) {
+	int worker = (int)(long)arg;
+	int generation_done = 0;
+
+	pthread_mutex_lock(&pool_lock);
+	while (true) {
+		while (pool_job_generation == generation_done) {
+			pthread_cond_wait(&pool_job_ready, &pool_lock);
+		}
+		generation_done = pool_job_generation;
+		// jobs with fewer workers than there are threads leave the extra threads waiting
+		if (worker >= pool_worker_count) {
+			continue;
+		}
+
+		pthread_mutex_unlock(&pool_lock);
+		pool_job(worker, pool_job_arg);
+		pthread_mutex_lock(&pool_lock);
+
+		pool_workers_remaining--;
+		if (pool_workers_remaining == 0) {
+			pthread_cond_signal(&pool_job_done);
+		}
+	}
+	return NULL;
+}
+
+bool host_load_key_script(const char* path) {
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		return false;
+	}
+
+	key_script_length = 0;
+	char line[128];
+	while (fgets(line, sizeof(line), file) != NULL && key_script_length < MAX_KEY_SCRIPT_STEPS) {
+		key_script_step step;
+		if (line[0] == '#' || sscanf(line, "%d %d", &step.key_value, &step.frame_count) != 2) {
+			continue;
+		}
+		key_script[key_script_length++] = step;
+	}
+	fclose(file);
+
+	key_script_loaded = true;
+	return true;
+}
+
+void host_set_frame_dump(const char* pattern) {
+	frame_dump_pattern = pattern;
+}
+
+void host_set_frame_limit(int frames) {
+	frame_limit = frames;
+}
+
+bool host_write_ppm(const char* path, const short int* buffer) {
+	FILE* file = fopen(path, "wb");
+	if (file == NULL) {
+		return false;
+	}
+
+	fprintf(file, "P6\n%d %d\n255\n", SCREEN_SIZE_X, SCREEN_SIZE_Y);
+
+	// expand RGB565 to 8 bits per channel
+	unsigned char row[SCREEN_SIZE_X * 3];
+	int x, y;
+	for (y = 0; y < SCREEN_SIZE_Y; y++) {
+		for (x = 0; x < SCREEN_SIZE_X; x++) {
+			unsigned short pixel = buffer[y * FRAME_BUFFER_STRIDE + x];
+			int r = (pixel >> 11) & 0x1F, g = (pixel >> 5) & 0x3F, b = pixel & 0x1F;
+			row[x * 3 + 0] = (r << 3) | (r >> 2);
+			row[x * 3 + 1] = (g << 2) | (g >> 4);
+			row[x * 3 + 2] = (b << 3) | (b >> 2);
+		}
+		fwrite(row, 1, sizeof(row), file);
+	}
+
+	bool ok = !ferror(file);
+	return fclose(file) == 0 && ok;
+}
+
+const short int* host_front_buffer(void) {
+	return (presented_buffer != NULL) ? presented_buffer : HOST_BUFFERS[0];
+}
+
+// ------------------------------------ profiling clock ------------------------------------
+
+#ifdef PROFILE_PERF
+// the perf_event counting this thread's CPU cycles, or -1 to fall back to clock_gettime
+int perf_cycles_fd = -1;
+#endif
+
+void backend_profile_clock_init(void) {
+#ifdef PROFILE_PERF
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = PERF_COUNT_HW_CPU_CYCLES;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	// counts the main thread only, so the draw stages only mean something with one worker
+	perf_cycles_fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	if (perf_cycles_fd < 0) {
+		fprintf(stderr, "raycast: no perf_event cycle counter, profiling with clock_gettime\n");
+	} else {
+		ioctl(perf_cycles_fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+unsigned int backend_profile_ticks(void) {
+#ifdef PROFILE_PERF
+	if (perf_cycles_fd >= 0) {
+		unsigned long long cycles = 0;
+		if (read(perf_cycles_fd, &cycles, sizeof(cycles)) == sizeof(cycles)) {
+			return (unsigned int)cycles;
+		}
+	}
+#endif
+	// nanoseconds, which wrap around every 4.3 seconds
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned int)(now.tv_sec * 1000000000ULL + now.tv_nsec);
+}
+
+unsigned int backend_profile_tick_rate(void) {
+#ifdef PROFILE_PERF
+	if (perf_cycles_fd >= 0) {
+		return 0;
+	}
+#endif
+	return 1000000000;
+}
+
+void backend_log(const char* text) {
+	fputs(text, stdout);
+	fflush(stdout);
+}
@@ -0,0 +1,50 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Linux-only controls of the host backend. backend_init reads the same settings from the environment:
+//   RAYCAST_KEYS    path to a key script, see host_load_key_script
+//   RAYCAST_DUMP    printf pattern for PPM frame dumps, e.g. "frames/frame_%04d.ppm"
+//   RAYCAST_FRAMES  number of frames to run when there is no key script (default 1)
+//   RAYCAST_MAP     path to a map file (see raycast-core/map_file.h) to use in place of MAP_DATA
+//   RAYCAST_VSYNC   refresh rate in Hz of the pixel buffer controller stand-in, see host_set_vsync
+//   RAYCAST_BUFFERS number of frame buffers, 2 or 3, see host_set_frame_buffers
+
+// loads a key script in place of KEY_BASE. Each line is "<key value> <frame count>", e.g. "8 12"
+// holds KEY3 for 12 frames. Lines starting with # are ignored. Returns false if the file can't be read.
+// While a key script plays each frame is one simulation tick (see input.h), and the changes reach the main
+// loop through KEY_EVENTS from a thread standing in for pushbutton_ISR (see backend_start_input)
+bool host_load_key_script(const char* path);
+
+// the number of frames the loaded key script lasts
+int host_key_script_frames(void);
+
+// dumps every presented frame as a PPM image, pattern is given the frame number. NULL stops dumping
+void host_set_frame_dump(const char* pattern);
+
+// stops the main loop after this many frames if no key script is loaded
+void host_set_frame_limit(int frames);
+
+// writes an RGB565 buffer with FRAME_BUFFER_STRIDE rows as a binary PPM (P6). Returns false on I/O errors
+bool host_write_ppm(const char* path, const short int* buffer);
+
+// maps a map file into memory and points MAP_GRID at it. Returns false if it can't be read or isn't a map file
+bool host_open_map(const char* path);
+
+// the number of bytes of the mapped map file this process has in memory, the bit planes and tile chunks
+size_t host_resident_map_bytes(void);
+
+// the buffer that was presented last, even if its swap is still waiting for V-Sync
+const short int* host_front_buffer(void);
+
+// makes the pixel buffer controller stand-in swap buffers only at V-Sync, refresh_hz times a second, as the
+// board does. 0 (the default) swaps at once
+void host_set_vsync(int refresh_hz);
+
+// presents frames with count buffers, 2 or 3, instead of PRESENT_BUFFERS (see backend/pixel_buffer.h) and
+// points FRAME_BUFFER_ADDR at the one to draw next. Returns false for any other count
+bool host_set_frame_buffers(int count);
+
+#endif // HOST_H
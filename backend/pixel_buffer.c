@@ -0,0 +1,45 @@
+#include "pixel_buffer.h"
+
+short int* present_buffers[PRESENT_MAX_BUFFERS];
+int present_buffer_count = 0;
+// the buffer being drawn to
+int present_drawing = 0;
+
+void present_wait(void) {
+	// the status bit is 1 during vysnc and returns to 0 when sync is complete (i.e. when buffer swap is complete)
+	while ((pixel_buf_read(PIXEL_BUF_STATUS) & PIXEL_BUF_SWAP_PENDING) != 0) {
+	}
+}
+
+short int* present_init(short int* const buffers[], int buffer_count) {
+	int i;
+	for (i = 0; i < buffer_count; i++) {
+		present_buffers[i] = buffers[i];
+	}
+	present_buffer_count = buffer_count;
+
+	present_wait();
+	pixel_buf_write(PIXEL_BUF_BACK, (uintptr_t)buffers[0]);
+	pixel_buf_write(PIXEL_BUF_FRONT, 1);
+	present_wait();
+
+	present_drawing = 1;
+	pixel_buf_write(PIXEL_BUF_BACK, (uintptr_t)buffers[1]);
+	return buffers[1];
+}
+
+short int* present_frame(void) {
+	// the controller only holds one request, so the last swap has to have happened before asking for this one.
+	// With three buffers that swap has had the whole frame to happen
+	present_wait();
+	pixel_buf_write(PIXEL_BUF_BACK, (uintptr_t)present_buffers[present_drawing]);
+	pixel_buf_write(PIXEL_BUF_FRONT, 1);
+
+	// the buffers take turns. The next one is the buffer that was on screen before the swap just asked for,
+	// with two buffers it still is until V-Sync
+	present_drawing = (present_drawing + 1) % present_buffer_count;
+	if (present_buffer_count == 2) {
+		present_wait();
+	}
+	return present_buffers[present_drawing];
+}
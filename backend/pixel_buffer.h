@@ -0,0 +1,47 @@
+#ifndef PIXEL_BUFFER_H
+#define PIXEL_BUFFER_H
+
+#include <stdint.h>
+
+// Presenting frames through the DE1-SoC pixel buffer controller, shared by both backends. The controller
+// has four registers, at PIXEL_BUF_CTRL_BASE on the board and in a stand-in on the host:
+//   PIXEL_BUF_FRONT   the buffer on screen. Writing 1 to it asks for a swap with the back buffer at the next V-Sync
+//   PIXEL_BUF_BACK    the back buffer
+//   PIXEL_BUF_STATUS  bit 0 is set from the swap request until the swap happens
+// The controller holds one swap request at a time.
+// With two buffers, the next frame is drawn over the buffer that is on screen until the swap, so presenting
+// waits for V-Sync every frame, and a frame that takes a little longer than a refresh waits for the one after.
+// With three (TRIPLE_BUFFER), the next frame is drawn into the third buffer while the swap is pending, and
+// presenting only waits if the swap of the frame before is still pending. Frame rates between the refresh
+// rate and half of it are kept instead of dropping to half.
+
+#define PIXEL_BUF_FRONT 0
+#define PIXEL_BUF_BACK 1
+#define PIXEL_BUF_RESOLUTION 2
+#define PIXEL_BUF_STATUS 3
+
+#define PIXEL_BUF_SWAP_PENDING 0x01
+
+#define PRESENT_MAX_BUFFERS 3
+
+#ifdef TRIPLE_BUFFER
+#define PRESENT_BUFFERS 3
+#else
+#define PRESENT_BUFFERS 2
+#endif
+
+// reads and writes a register of the pixel buffer controller. Provided by the linked backend. Addresses are
+// 32 bits on the board, the host stand-in holds pointers
+uintptr_t pixel_buf_read(int reg);
+void pixel_buf_write(int reg, uintptr_t value);
+
+// puts buffers[0] on screen and returns buffers[1] to draw the first frame into. buffer_count is 2 or 3
+short int* present_init(short int* const buffers[], int buffer_count);
+
+// asks for the buffer being drawn to be shown at the next V-Sync, and returns the buffer to draw the next frame into
+short int* present_frame(void);
+
+// waits until the last swap asked for has happened
+void present_wait(void);
+
+#endif // PIXEL_BUFFER_H
@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "batch.h"
+#include "../render/render.h"
+#include "../backend/backend.h"
+#include "../backend/host.h"
+#include "../raycast-core/map_grid.h"
+#include "../Map_Data.h"
+
+#define FRAME_BYTES (SCREEN_SIZE_X * SCREEN_SIZE_Y * (int)sizeof(short int))
+
+// what every worker of batch_render shares
+typedef struct batch_job {
+	const batch_pose* poses;
+	int count;
+	batch_format format;
+	const char* path;
+	// the packed file, written at each frame's offset so workers don't wait for each other
+	int packed_file;
+	// the next pose a worker takes, and whether any frame couldn't be written
+	int next_pose;
+	bool failed;
+} batch_job;
+
+// the render target of one worker and everything it points to
+typedef struct batch_target {
+	render_target target;
+	short int frame_buffer[SCREEN_SIZE_Y * FRAME_BUFFER_STRIDE];
+	frame_slices slices;
+	int column_pixel_writes[SCREEN_SIZE_X];
+	sprite_frame sprites;
+	ray_cache cache;
+	// a frame's rows without the padding out to FRAME_BUFFER_STRIDE, for the raw and packed formats
+	short int pixels[SCREEN_SIZE_X * SCREEN_SIZE_Y];
+} batch_target;
+
+void batch_worker(int worker, void* arg);
+bool write_batch_frame(batch_job* job, int pose, batch_target* own);
+double batch_seconds(struct timespec* start, struct timespec* end);
+
+int batch_format_named(const char* name) {
+	if (strcmp(name, "none") == 0) return BATCH_NONE;
+	if (strcmp(name, "ppm") == 0) return BATCH_PPM;
+	if (strcmp(name, "raw") == 0) return BATCH_RAW;
+	if (strcmp(name, "packed") == 0) return BATCH_PACKED;
+	return -1;
+}
+
+int batch_read_poses(const char* path, batch_pose** poses) {
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		return -1;
+	}
+
+	int count = 0, capacity = 1024;
+	*poses = malloc(capacity * sizeof(batch_pose));
+	if (*poses == NULL) {
+		fclose(file);
+		return -1;
+	}
+	char line[128];
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (line[0] == '#' || line[0] == '\n') {
+			continue;
+		}
+		batch_pose pose;
+		if (sscanf(line, "%d %d %d", &pose.x, &pose.y, &pose.angle) != 3) {
+			fclose(file);
+			free(*poses);
+			*poses = NULL;
+			return -1;
+		}
+		if (count == capacity) {
+			// keep the poses read so far if the larger block can't be had, so they can be freed
+			batch_pose* grown = realloc(*poses, 2 * capacity * sizeof(batch_pose));
+			if (grown == NULL) {
+				fclose(file);
+				free(*poses);
+				*poses = NULL;
+				return -1;
+			}
+			*poses = grown;
+			capacity *= 2;
+		}
+		pose.angle = wrap_angle(pose.angle);
+		(*poses)[count++] = pose;
+	}
+	fclose(file);
+	return count;
+}
+
+bool batch_render(const batch_pose* poses, int count, int worker_count, batch_format format, const char* path, batch_stats* stats) {
+	// the workers backend_parallel_for actually runs, which the stats report
+	worker_count = backend_workers(worker_count);
+
+	batch_job job;
+	job.poses = poses;
+	job.count = count;
+	job.format = format;
+	job.path = path;
+	job.packed_file = -1;
+	job.next_pose = 0;
+	job.failed = false;
+
+	if (format == BATCH_PACKED) {
+		job.packed_file = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		batch_packed_header header = { BATCH_PACKED_MAGIC, BATCH_PACKED_VERSION, SCREEN_SIZE_X, SCREEN_SIZE_Y, count, sizeof(batch_packed_header) };
+		if (job.packed_file < 0 || write(job.packed_file, &header, sizeof(header)) != sizeof(header)) {
+			if (job.packed_file >= 0) close(job.packed_file);
+			return false;
+		}
+	}
+
+	// the workers only read the map, so it is snapshot once for the whole batch
+	if (!MAP_GRID.read_only) {
+		snapshot_map();
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	backend_parallel_for(worker_count, batch_worker, &job);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	// every worker takes poses until they run out, so poses are left only if no worker had the memory to draw
+	if (job.next_pose < count) {
+		job.failed = true;
+	}
+	if (job.packed_file >= 0 && close(job.packed_file) != 0) {
+		job.failed = true;
+	}
+
+	if (stats != NULL) {
+		long cores = sysconf(_SC_NPROCESSORS_ONLN);
+		stats->frames = count;
+		stats->workers = worker_count;
+		stats->cores = (cores > 0 && cores < worker_count) ? (int)cores : worker_count;
+		stats->seconds = batch_seconds(&start, &end);
+		stats->frames_per_second = count / stats->seconds;
+		stats->frames_per_second_per_core = stats->frames_per_second / stats->cores;
+	}
+	return !job.failed;
+}
+
+void batch_worker(int worker, void* arg) {
+	batch_job* job = arg;
+
+	batch_target* own = malloc(sizeof(batch_target));
+	if (own == NULL) {
+		// the other workers draw the poses, batch_render fails if none of them could
+		return;
+	}
+	own->target.frame_buffer = own->frame_buffer;
+	own->target.slices = &own->slices;
+	own->target.column_pixel_writes = own->column_pixel_writes;
+	own->target.sprites = &own->sprites;
+	// poses in a row from the same position, such as a turn on the spot, reuse each other's rays
+	own->target.cache = &own->cache;
+	// a frame buffer is written out as soon as it is drawn, and drawn again from the next pose
+	own->target.history = NULL;
+	ray_cache_init(&own->cache);
+
+	while (true) {
+		int pose = __atomic_fetch_add(&job->next_pose, 1, __ATOMIC_RELAXED);
+		if (pose >= job->count) {
+			break;
+		}
+		const batch_pose* at = &job->poses[pose];
+		draw_frame_target(&own->target, at->x, at->y, at->angle, 1);
+		if (!write_batch_frame(job, pose, own)) {
+			__atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+		}
+	}
+	free(own);
+}
+
+bool write_batch_frame(batch_job* job, int pose, batch_target* own) {
+	if (job->format == BATCH_NONE) {
+		return true;
+	}
+	if (job->format == BATCH_PPM) {
+		char path[4096];
+		snprintf(path, sizeof(path), job->path, pose);
+		return host_write_ppm(path, own->frame_buffer);
+	}
+
+	int y;
+	for (y = 0; y < SCREEN_SIZE_Y; y++) {
+		memcpy(own->pixels + y * SCREEN_SIZE_X, own->frame_buffer + y * FRAME_BUFFER_STRIDE, SCREEN_SIZE_X * sizeof(short int));
+	}
+
+	if (job->format == BATCH_PACKED) {
+		off_t offset = sizeof(batch_packed_header) + (off_t)pose * FRAME_BYTES;
+		return pwrite(job->packed_file, own->pixels, FRAME_BYTES, offset) == FRAME_BYTES;
+	}
+
+	char path[4096];
+	snprintf(path, sizeof(path), job->path, pose);
+	FILE* file = fopen(path, "wb");
+	if (file == NULL) {
+		return false;
+	}
+	bool written = fwrite(own->pixels, FRAME_BYTES, 1, file) == 1;
+	return (fclose(file) == 0) && written;
+}
+
+double batch_seconds(struct timespec* start, struct timespec* end) {
+	return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
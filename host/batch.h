@@ -0,0 +1,67 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdbool.h>
+
+// Offline batch renderer, for generating datasets of first person frames from scripted poses on the host.
+// batch_render hands the poses out to worker_count workers on the backend's thread pool (backend_parallel_for).
+// Each worker draws whole frames into its own render_target (see render/render.h): its own frame buffer,
+// slices and sprite list. Every worker shares MAP_GRID, the textures and the sprites, which don't change while
+// the batch runs. A worker takes the next pose as soon as it finishes a frame, so frames are drawn out of order.
+// Every frame still goes to the file or place in the packed file of its pose.
+// build/batch_render renders a pose file from the command line.
+
+// a pose to draw. x and y are unit coordinates, angle is a binary angle (see raycast-core/raycast.h)
+typedef struct batch_pose {
+	int x;
+	int y;
+	int angle;
+} batch_pose;
+
+typedef enum batch_format {
+	// nothing written, to time the rendering alone
+	BATCH_NONE,
+	// a PPM image per pose (see host_write_ppm). The path is a printf pattern given the pose's index
+	BATCH_PPM,
+	// a file per pose of SCREEN_SIZE_Y rows of SCREEN_SIZE_X RGB565 pixels, little endian. The path is a pattern
+	BATCH_RAW,
+	// one file: a batch_packed_header, then every frame as in BATCH_RAW, in pose order
+	BATCH_PACKED
+} batch_format;
+
+#define BATCH_PACKED_MAGIC 0x46425352	// "RSBF" in a little endian file
+#define BATCH_PACKED_VERSION 1
+
+// the start of a BATCH_PACKED file, all little endian
+typedef struct batch_packed_header {
+	unsigned int magic;
+	unsigned int version;
+	unsigned int width;
+	unsigned int height;
+	unsigned int frame_count;
+	// bytes from the start of the file to the first frame
+	unsigned int frame_offset;
+} batch_packed_header;
+
+typedef struct batch_stats {
+	int frames;
+	int workers;
+	// the cores the workers could run on, at most workers
+	int cores;
+	double seconds;
+	double frames_per_second;
+	double frames_per_second_per_core;
+} batch_stats;
+
+// reads a pose file: one "x y angle" per line, lines starting with # are ignored. Returns the number of poses and
+// points poses at them (free it when done), or returns -1 if the file can't be read, has a line that isn't a pose or the poses don't fit in memory
+int batch_read_poses(const char* path, batch_pose** poses);
+
+// draws count poses with worker_count workers and writes them out in format to path. Takes a snapshot of MAP_DATA
+// first unless MAP_GRID is read only. Fills in stats if it isn't NULL. Returns false if any frame couldn't be written
+bool batch_render(const batch_pose* poses, int count, int worker_count, batch_format format, const char* path, batch_stats* stats);
+
+// the format named "ppm", "raw", "packed" or "none", or -1 for any other name
+int batch_format_named(const char* name);
+
+#endif // BATCH_H
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "batch.h"
+#include "../render/render.h"
+#include "../backend/backend.h"
+#include "../Map_Data.h"
+
+// Renders every pose of a pose file with the batch renderer (see batch.h) and reports frames/sec per core.
+// The map is the built in one, or the map file RAYCAST_MAP names (see backend/host.h).
+// usage: batch_render <pose file> [workers] [format] [output]
+//        workers defaults to the number of cores. format is ppm, raw, packed or none (the default, nothing is
+//        written). output is a printf pattern given each pose's index for ppm and raw, e.g. frames/%06d.ppm,
+//        and the file to write for packed
+
+int main(int argc, char** argv) {
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	int workers = (argc > 2) ? atoi(argv[2]) : (cores > 0 ? (int)cores : 1);
+	int format = (argc > 3) ? batch_format_named(argv[3]) : BATCH_NONE;
+	const char* output = (argc > 4) ? argv[4] : NULL;
+	if (argc < 2 || workers < 1 || format < 0 || (format != BATCH_NONE && output == NULL)) {
+		fprintf(stderr, "usage: %s <pose file> [workers] [ppm|raw|packed|none] [output]\n", argv[0]);
+		return 1;
+	}
+
+	batch_pose* poses;
+	int count = batch_read_poses(argv[1], &poses);
+	if (count < 0) {
+		fprintf(stderr, "batch_render: can't read poses from %s\n", argv[1]);
+		return 1;
+	}
+
+	backend_init();
+	if (!backend_load_map()) {
+		config_map();
+		config_sprites();
+	}
+	init_render();
+
+	batch_stats stats;
+	bool written = batch_render(poses, count, workers, (batch_format)format, output, &stats);
+	free(poses);
+	if (!written) {
+		fprintf(stderr, "batch_render: couldn't write every frame to %s\n", output);
+		return 1;
+	}
+
+	printf("frames:          %d\n", stats.frames);
+	printf("workers:         %d on %d cores\n", stats.workers, stats.cores);
+	printf("time:            %.3f s\n", stats.seconds);
+	printf("frames/sec:      %.1f\n", stats.frames_per_second);
+	printf("frames/sec/core: %.1f\n", stats.frames_per_second_per_core);
+	return 0;
+}
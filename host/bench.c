@@ -0,0 +1,1609 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "../raycast-core/raycast.h"
+#include "../render/render.h"
+#include "../render/shade.h"
+#include "../render/raster.h"
+#include "../render/sprite.h"
+#include "../render/resolution.h"
+#include "../render/palette.h"
+#include "../backend/backend.h"
+#include "../raycast-core/map_grid.h"
+#include "../raycast-core/map_file.h"
+#include "../raycast-core/ray_packet.h"
+#include "../backend/host.h"
+#include "../Map_Data.h"
+#include "../player.h"
+#include "../input.h"
+#include "maze.h"
+#include "batch.h"
+
+// Times draw_frame on the host backend. The player stands at the default start position and turns
+// by one KEY press (5 * RAY_ANGLE_INC) every frame, so the frames sweep every view direction.
+// usage: bench [frames] [workers]   draws with draw_frame_parallel, after checking it matches draw_frame
+//        bench --compare             checks that cast_ray_fixed gives the same slice sizes as cast_ray, failing if
+//                                    any is off by more than COMPARE_MAX_DIFFERENCE or too many differ
+//        bench --map-scaling         times rays across open maps from 64 x 64 up to MAP_MAX_SIZE cells a side,
+//                                    with and without the empty space skipping of the map pyramid
+//        bench --suite [baseline]    replays every scenario's camera path and compares the results with a baseline
+//                                    (default traces/baseline.txt), failing if any is slower or takes more steps
+//        bench --suite-record [file] runs the scenarios and writes their results as the new baseline
+//        bench --raster              checks every raster kernel against its scalar version, then times them both
+//        bench --map-stream [file]   writes a MAP_MAX_SIZE map file (default /tmp/bench.rmap), then walks across
+//                                    it and reports how much of it stays in memory
+//        bench --input-queue         pushes key events from a thread standing in for the ISR as fast as the main
+//                                    thread pops them, checking none are lost, repeated or reordered. Then pushes
+//                                    faster than it pops, checking the KEYs pushed last come out of the overflow
+//        bench --sprites             turns on the spot with growing numbers of sprites scattered over the map, and
+//                                    reports the frame rate and how many sprites were drawn, culled and hidden
+//        bench --present             draws frames that take longer than a 60 Hz refresh against the simulated
+//                                    pixel buffer controller, with two and three frame buffers, and reports frames/sec
+//        bench --packets             checks that packets of rays give the same hits as tracing them one at a time,
+//                                    then times both in rays/sec on the built in map, mazes and an open map
+//        bench --dynamic-resolution  times frames cast at every column shift, then runs the resolution controller
+//                                    at budgets under the full resolution frame time and reports the levels it picked
+//        bench --batch               renders poses all over the built in map with the batch renderer, checks its
+//                                    packed file against draw_frame, then reports frames/sec per core by workers
+//        bench --palette             compares frames drawn from 8 bit indexed textures with RGB565 ones, without
+//                                    mipmaps they must be identical, then times both turning and standing and
+//                                    reports the pixel and texel bytes per frame
+//        bench --dirty-columns       checks that skipping the columns a frame buffer already holds draws the same
+//                                    frames, then times standing, turning and walking with and without it
+//        bench --mipmaps             checks that mipmaps only change walls half the texture tall or less, then walks
+//                                    and turns slowly down the corridor and reports how much the far walls change from
+//                                    frame to frame, the texture cache lines read and the frame rate, with and without
+
+#define DEFAULT_FRAMES 2000
+// bench --compare fails if a slice size differs by more pixels than this, or more than this percentage of them do.
+// With the DDA traversal of both casters 0.044% differ, by a pixel each
+#define COMPARE_MAX_DIFFERENCE 1
+#define COMPARE_MAX_MISMATCH_PERCENT 0.1
+#define SCALING_PILLARS 64
+// more workers than backend_parallel_for runs, which draw_frame_parallel has to clamp
+#define EXCESS_WORKERS (BACKEND_MAX_WORKERS + 36)
+#define SCALING_ANGLE_STEP 15
+#define RASTER_FRAMES 2000
+#define SUITE_BASELINE "traces/baseline.txt"
+// frames a maze scenario's camera turns on the spot in one room, before it moves to the next
+#define SUITE_ROOM_FRAMES 64
+// a scenario fails if its rays/sec drops by more than this fraction of the baseline, its p99 frame time grows
+// by more than SUITE_P99_TOLERANCE times, or it takes more than this fraction more steps per ray
+#define SUITE_SPEED_TOLERANCE 0.25
+#define SUITE_P99_TOLERANCE 3.0
+#define SUITE_STEPS_TOLERANCE 0.01
+#define INPUT_QUEUE_EVENTS 20000000
+#define SPRITE_BENCH_FRAMES 768
+// south of the long wall of the built in map, which hides the sprites in the rooms north of it
+#define SPRITE_BENCH_X (9 * 64 + 32)
+#define SPRITE_BENCH_Y (12 * 64 + 32)
+#define PRESENT_REFRESH_HZ 60
+#define PRESENT_FRAMES 30
+#define PRESENT_BUFFERS_WARMUP 4
+#define RESOLUTION_BENCH_FRAMES 2000
+// camera positions each map of bench --packets casts every angle from
+#define PACKET_BENCH_POSES 64
+#define RESOLUTION_BENCH_WORKERS 4
+// view directions bench --batch draws from every open cell, and the packed file it checks
+#define BATCH_BENCH_ANGLES 16
+#define BATCH_BENCH_FILE "/tmp/bench_batch.rbf"
+#define PALETTE_BENCH_FRAMES 2000
+// frames of each part of the bench --dirty-columns camera path
+#define DIRTY_PATH_FRAMES 24
+#define DIRTY_BENCH_FRAMES 2000
+// frames of bench --mipmaps' walk and turn, one unit or binary angle apart, and walls this tall or less are far
+#define MIPMAP_PATH_FRAMES 128
+#define MIPMAP_FAR_WALL (TEXTURE_SIZE / 2)
+#define CACHE_LINE 64
+#define MIPMAP_REPEATS 8
+
+double elapsed_seconds(struct timespec* start, struct timespec* end) {
+	return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// casts every column at every angle from each open map cell with both ray casters and
+// reports how many slice sizes differ. They only differ where a ray passes exactly through a grid
+// corner or a slice size lands on a rounding boundary, where the double path is no more correct.
+// Returns false if they differ by more than COMPARE_MAX_DIFFERENCE and COMPARE_MAX_MISMATCH_PERCENT allow
+bool compare_ray_casters() {
+	int columns = 0, mismatches = 0, max_difference = 0;
+	frame_slices double_slices, fixed_slices;
+
+	int cell_x, cell_y, angle, column;
+	for (cell_x = 0; cell_x < 16; cell_x++) {
+		for (cell_y = 0; cell_y < 16; cell_y++) {
+			if (MAP_DATA[cell_x][cell_y] != 0) continue;
+			// somewhere off-center in the cell, so rays don't line up with the grid
+			int player_x = (cell_x << 6) + 21, player_y = (cell_y << 6) + 40;
+
+			for (angle = 0; angle < ANGLE_UNITS; angle += 5) {
+				for (column = 0; column < SCREEN_SIZE_X; column += 7) {
+					cast_ray(player_x, player_y, angle, column, &double_slices);
+					cast_ray_fixed(player_x, player_y, angle, column, &fixed_slices);
+
+					int double_size = double_slices.size[column], fixed_size = fixed_slices.size[column];
+					if (double_size != fixed_size) {
+						int difference = (double_size == INT_MAX || fixed_size == INT_MAX) ? INT_MAX : abs(double_size - fixed_size);
+						if (difference > max_difference) max_difference = difference;
+						mismatches++;
+					}
+					columns++;
+				}
+			}
+		}
+	}
+
+	printf("compared:    %d slices\n", columns);
+	printf("mismatches:  %d (%.4f%%), largest difference %d pixels\n", mismatches, 100.0 * mismatches / columns, max_difference);
+	if (max_difference > COMPARE_MAX_DIFFERENCE || 100.0 * mismatches / columns > COMPARE_MAX_MISMATCH_PERCENT) {
+		fprintf(stderr, "bench: the ray casters differ by more than %d pixels or on more than %.2f%% of slices\n",
+			COMPARE_MAX_DIFFERENCE, COMPARE_MAX_MISMATCH_PERCENT);
+		return false;
+	}
+	return true;
+}
+
+// draws a frame at every view direction both with draw_frame and draw_frame_parallel, and
+// returns true if the frame buffers are identical
+bool parallel_output_matches(int player_x, int player_y, int worker_count) {
+	static short int serial_frame[SCREEN_SIZE_Y * FRAME_BUFFER_STRIDE];
+	size_t frame_bytes = sizeof(serial_frame);
+
+	int angle;
+	for (angle = 0; angle < ANGLE_UNITS; angle += 5) {
+		memset(FRAME_BUFFER_ADDR, 0, frame_bytes);
+		forget_drawn_frames();
+		draw_frame_parallel(player_x, player_y, angle, 1);
+		memcpy(serial_frame, FRAME_BUFFER_ADDR, frame_bytes);
+
+		memset(FRAME_BUFFER_ADDR, 0, frame_bytes);
+		forget_drawn_frames();
+		draw_frame_parallel(player_x, player_y, angle, worker_count);
+		if (memcmp(serial_frame, FRAME_BUFFER_ADDR, frame_bytes) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// builds a size x size map with walls around the edge and SCALING_PILLARS single cell pillars at random
+// positions. The number of pillars stays the same at every size, so bigger maps have more open space
+void build_scaling_map(map_grid* map, int size, void* storage) {
+	map_init(map, size, size, storage);
+
+	int i;
+	for (i = 0; i < size; i++) {
+		map_set_cell(map, i, 0, 1);
+		map_set_cell(map, i, size - 1, 1);
+		map_set_cell(map, 0, i, 1);
+		map_set_cell(map, size - 1, i, 1);
+	}
+
+	// the same pillars every run
+	unsigned int seed = 12345;
+	for (i = 0; i < SCALING_PILLARS; i++) {
+		seed = seed * 1103515245 + 12345;
+		int x = 1 + (seed >> 8) % (size - 2);
+		seed = seed * 1103515245 + 12345;
+		int y = 1 + (seed >> 8) % (size - 2);
+		// keep the player's cell open
+		if (x != size / 2 || y != size / 2) map_set_cell(map, x, y, 1);
+	}
+	map_build_pyramid(map);
+}
+
+// casts frames at every SCALING_ANGLE_STEP from the middle of MAP_GRID into slices, and returns the seconds taken
+double time_scaling_frames(frame_slices* slices) {
+	int player_x = ((MAP_GRID.size_x / 2) << 6) + 21, player_y = ((MAP_GRID.size_y / 2) << 6) + 40;
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	int angle;
+	for (angle = 0; angle < ANGLE_UNITS; angle += SCALING_ANGLE_STEP) {
+		cast_frame(player_x, player_y, angle, &slices[angle / SCALING_ANGLE_STEP]);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return elapsed_seconds(&start, &end);
+}
+
+// times rays across maps of growing size, with the full pyramid and with level 0 only (one step per cell).
+// The slices must come out the same either way
+int map_scaling() {
+	int frame_count = ANGLE_UNITS / SCALING_ANGLE_STEP;
+	frame_slices* skipping_slices = malloc(frame_count * sizeof(frame_slices));
+	frame_slices* stepping_slices = malloc(frame_count * sizeof(frame_slices));
+	int rays = frame_count * SCREEN_SIZE_X;
+
+	printf("%-12s %-8s %-14s %-14s %s\n", "map", "levels", "ns/ray", "ns/ray", "mismatches");
+	printf("%-12s %-8s %-14s %-14s\n", "", "", "(skipping)", "(per cell)");
+
+	int size, failures = 0;
+	for (size = 64; size <= MAP_MAX_SIZE; size *= 2) {
+		void* storage = malloc(map_storage_size(size, size));
+		build_scaling_map(&MAP_GRID, size, storage);
+
+		// warm up, then take the best of a few runs
+		time_scaling_frames(skipping_slices);
+		double skipping = 1e9, stepping = 1e9;
+		int run;
+		for (run = 0; run < 3; run++) {
+			double seconds = time_scaling_frames(skipping_slices);
+			if (seconds < skipping) skipping = seconds;
+		}
+
+		int level_count = MAP_GRID.level_count;
+		MAP_GRID.level_count = 1;
+		for (run = 0; run < 3; run++) {
+			double seconds = time_scaling_frames(stepping_slices);
+			if (seconds < stepping) stepping = seconds;
+		}
+		MAP_GRID.level_count = level_count;
+
+		int frame, column, mismatches = 0;
+		for (frame = 0; frame < frame_count; frame++) {
+			for (column = 0; column < SCREEN_SIZE_X; column++) {
+				if (skipping_slices[frame].size[column] != stepping_slices[frame].size[column]) mismatches++;
+			}
+		}
+#ifdef RAYCAST_FIXED_POINT
+		// the fixed point skip is exact
+		failures += mismatches;
+#endif
+
+		char name[32];
+		snprintf(name, sizeof(name), "%d x %d", size, size);
+		printf("%-12s %-8d %-14.1f %-14.1f %d\n", name, level_count, skipping * 1e9 / rays, stepping * 1e9 / rays, mismatches);
+		free(storage);
+	}
+
+	free(skipping_slices);
+	free(stepping_slices);
+	return failures;
+}
+
+// walks the player diagonally across a MAP_MAX_SIZE map file, casting a frame at every step, and reports
+// how long the file took to load and the most of it that was in memory at once
+int map_stream(const char* path) {
+	map_grid map;
+	void* storage = malloc(map_storage_size(MAP_MAX_SIZE, MAP_MAX_SIZE));
+	build_scaling_map(&map, MAP_MAX_SIZE, storage);
+	bool written = map_write_file(&map, path);
+	free(storage);
+	if (!written) {
+		fprintf(stderr, "bench: could not write %s\n", path);
+		return 1;
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	bool opened = host_open_map(path);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	if (!opened) {
+		fprintf(stderr, "bench: could not load %s\n", path);
+		return 1;
+	}
+
+	frame_slices slices;
+	int step, steps = 0;
+	size_t max_resident = 0;
+	for (step = MAP_CHUNK_SIZE; step < MAP_MAX_SIZE - MAP_CHUNK_SIZE; step += 16) {
+		int player_x = (step << 6) + 21, player_y = (step << 6) + 40;
+		backend_stream_map(player_x, player_y);
+		cast_frame(player_x, player_y, (step * 7) % ANGLE_UNITS, &slices);
+
+		size_t resident = host_resident_map_bytes();
+		if (resident > max_resident) max_resident = resident;
+		steps++;
+	}
+
+	printf("map:           %d x %d cells, %d KB file\n", MAP_GRID.size_x, MAP_GRID.size_y, (int)(map_storage_size(MAP_MAX_SIZE, MAP_MAX_SIZE) / 1024));
+	printf("load time:     %.3f ms\n", elapsed_seconds(&start, &end) * 1e3);
+	printf("frames:        %d\n", steps);
+	printf("max resident:  %d KB\n", (int)(max_resident / 1024));
+	return 0;
+}
+
+// ---- benchmark suite ----
+
+// A scenario is a map and a camera path. The path is either a key script (see backend/host.h) replayed through
+// player_apply_keys from the start position, or for the synthetic mazes, a turn on the spot in one random room
+// after another. Either way every run draws the same frames
+typedef struct suite_scenario {
+	const char* name;
+	// key script to replay on the built in map, or NULL for a maze_size x maze_size maze
+	const char* key_script;
+	int maze_size;
+	int frames;
+} suite_scenario;
+
+static const suite_scenario SUITE_SCENARIOS[] = {
+	{ "spin", "traces/spin.keys", 0, 0 },
+	{ "walk", "traces/walk.keys", 0, 0 },
+	{ "maze-256", NULL, 256, 512 },
+	{ "maze-1024", NULL, 1024, 512 },
+	{ "maze-4096", NULL, 4096, 512 },
+};
+#define SUITE_SCENARIO_COUNT ((int)(sizeof(SUITE_SCENARIOS) / sizeof(SUITE_SCENARIOS[0])))
+
+typedef struct suite_result {
+	char name[32];
+	int frames;
+	// frame times in ms
+	double p50;
+	double p90;
+	double p99;
+	double max;
+	double rays_per_second;
+	double steps_per_ray;
+} suite_result;
+
+int compare_doubles(const void* a, const void* b) {
+	double difference = *(const double*)a - *(const double*)b;
+	return (difference > 0) - (difference < 0);
+}
+
+// the camera pose of frame of a maze scenario: the middle of a random room, turning
+void maze_camera(int frame, int maze_size, player_state* player) {
+	unsigned int seed = 1 + frame / SUITE_ROOM_FRAMES;
+	int rooms = (maze_size - 1) / 2;
+	maze_random(&seed);
+	int room_x = maze_random(&seed) % rooms, room_y = maze_random(&seed) % rooms;
+	player->x = ((2 * room_x + 1) << 6) + 32;
+	player->y = ((2 * room_y + 1) << 6) + 32;
+	player->angle = wrap_angle(seed % ANGLE_UNITS + (frame % SUITE_ROOM_FRAMES) * 3 * PLAYER_TURN_STEP);
+}
+
+// draws every frame of scenario, timing each one. Returns false if its map or key script can't be loaded
+bool run_scenario(const suite_scenario* scenario, suite_result* result) {
+	void* storage = NULL;
+	int frames = scenario->frames;
+	if (scenario->key_script != NULL) {
+		config_map();
+		if (!host_load_key_script(scenario->key_script)) {
+			fprintf(stderr, "bench: could not read key script %s\n", scenario->key_script);
+			return false;
+		}
+		// the key script sets how many frames there are, and replays from frame 0
+		frames = host_key_script_frames();
+		backend_init();
+		forget_drawn_frames();
+	} else {
+		storage = malloc(map_storage_size(scenario->maze_size, scenario->maze_size));
+		if (storage == NULL || !build_maze(&MAP_GRID, scenario->maze_size, 1, storage)) {
+			fprintf(stderr, "bench: could not build a %d x %d maze\n", scenario->maze_size, scenario->maze_size);
+			free(storage);
+			return false;
+		}
+		// so draw_frame doesn't copy MAP_DATA over it
+		MAP_GRID.read_only = true;
+	}
+
+	double* frame_ms = malloc(frames * sizeof(double));
+	long long steps = 0;
+	double total = 0;
+	player_state player = { PLAYER_START_X, PLAYER_START_Y, PLAYER_START_ANGLE };
+	// every column is cast, so rays/sec and steps/ray measure the ray caster and not how many rays were reused
+	RAY_REUSE_ENABLED = false;
+
+	int frame, i;
+	for (frame = 0; frame < frames; frame++) {
+		if (scenario->key_script != NULL) {
+			player_apply_keys(&player, backend_read_keys());
+		} else {
+			maze_camera(frame, scenario->maze_size, &player);
+		}
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		draw_frame(player.x, player.y, player.angle);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		backend_swap_buffers();
+
+		frame_ms[frame] = elapsed_seconds(&start, &end) * 1e3;
+		total += frame_ms[frame];
+		for (i = 0; i < SCREEN_SIZE_X; i++) steps += FRAME_SLICES.steps[i];
+	}
+
+	RAY_REUSE_ENABLED = true;
+
+	qsort(frame_ms, frames, sizeof(double), compare_doubles);
+	snprintf(result->name, sizeof(result->name), "%s", scenario->name);
+	result->frames = frames;
+	result->p50 = frame_ms[frames / 2];
+	result->p90 = frame_ms[(frames * 90 + 99) / 100 - 1];
+	result->p99 = frame_ms[(frames * 99 + 99) / 100 - 1];
+	result->max = frame_ms[frames - 1];
+	result->rays_per_second = (double)frames * SCREEN_SIZE_X / (total / 1e3);
+	result->steps_per_ray = (double)steps / ((double)frames * SCREEN_SIZE_X);
+
+	free(frame_ms);
+	// snapshot_map lays MAP_GRID out over MAP_DATA's storage again for the next scenario that uses it
+	free(storage);
+	return true;
+}
+
+// reads a baseline written by --suite-record. Returns the number of results read, or -1 if it can't be read
+int read_baseline(const char* path, suite_result* baseline, int max_results) {
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		return -1;
+	}
+	int count = 0;
+	char line[256];
+	while (count < max_results && fgets(line, sizeof(line), file) != NULL) {
+		suite_result* result = &baseline[count];
+		if (line[0] != '#' && sscanf(line, "%31s %d %lf %lf %lf %lf %lf %lf", result->name, &result->frames, &result->p50,
+				&result->p90, &result->p99, &result->max, &result->rays_per_second, &result->steps_per_ray) == 8) {
+			count++;
+		}
+	}
+	fclose(file);
+	return count;
+}
+
+bool write_baseline(const char* path, suite_result* results, int count) {
+	FILE* file = fopen(path, "w");
+	if (file == NULL) {
+		return false;
+	}
+#ifdef RAYCAST_FIXED_POINT
+	fprintf(file, "# bench --suite baseline, fixed point ray caster, %s raster kernels\n", RASTER_KERNELS);
+#else
+	fprintf(file, "# bench --suite baseline, double ray caster, %s raster kernels\n", RASTER_KERNELS);
+#endif
+	fprintf(file, "# scenario frames p50_ms p90_ms p99_ms max_ms rays/sec steps/ray\n");
+	int i;
+	for (i = 0; i < count; i++) {
+		fprintf(file, "%s %d %.4f %.4f %.4f %.4f %.0f %.4f\n", results[i].name, results[i].frames, results[i].p50,
+			results[i].p90, results[i].p99, results[i].max, results[i].rays_per_second, results[i].steps_per_ray);
+	}
+	return fclose(file) == 0;
+}
+
+// prints every way result is worse than the baseline by more than the tolerances, and returns how many there are
+int compare_with_baseline(suite_result* result, suite_result* baseline) {
+	int regressions = 0;
+	if (result->rays_per_second < baseline->rays_per_second * (1 - SUITE_SPEED_TOLERANCE)) {
+		printf("REGRESSION %s: %.0f rays/sec, %.0f%% below the baseline %.0f\n", result->name, result->rays_per_second,
+			100 * (1 - result->rays_per_second / baseline->rays_per_second), baseline->rays_per_second);
+		regressions++;
+	}
+	if (result->p99 > baseline->p99 * SUITE_P99_TOLERANCE) {
+		printf("REGRESSION %s: p99 frame time %.3f ms, the baseline is %.3f ms\n", result->name, result->p99, baseline->p99);
+		regressions++;
+	}
+	if (result->steps_per_ray > baseline->steps_per_ray * (1 + SUITE_STEPS_TOLERANCE)) {
+		printf("REGRESSION %s: %.3f steps/ray, the baseline is %.3f\n", result->name, result->steps_per_ray, baseline->steps_per_ray);
+		regressions++;
+	}
+	return regressions;
+}
+
+// runs every scenario, then writes the results to baseline_path if record is true, or compares them with it.
+// Returns the number of regressions
+int run_suite(const char* baseline_path, bool record) {
+	suite_result results[SUITE_SCENARIO_COUNT], baseline[SUITE_SCENARIO_COUNT];
+	int baseline_count = record ? 0 : read_baseline(baseline_path, baseline, SUITE_SCENARIO_COUNT);
+	if (!record && baseline_count < 0) {
+		printf("no baseline at %s, run bench --suite-record to make one\n", baseline_path);
+	}
+
+	backend_init();
+	init_render();
+
+	printf("%-10s %6s %8s %8s %8s %8s %12s %9s\n", "scenario", "frames", "p50 ms", "p90 ms", "p99 ms", "max ms", "rays/sec", "steps/ray");
+	int i, j, regressions = 0;
+	for (i = 0; i < SUITE_SCENARIO_COUNT; i++) {
+		if (!run_scenario(&SUITE_SCENARIOS[i], &results[i])) {
+			return 1;
+		}
+		suite_result* result = &results[i];
+		printf("%-10s %6d %8.3f %8.3f %8.3f %8.3f %12.0f %9.3f\n", result->name, result->frames, result->p50, result->p90,
+			result->p99, result->max, result->rays_per_second, result->steps_per_ray);
+
+		for (j = 0; j < baseline_count; j++) {
+			if (strcmp(baseline[j].name, result->name) == 0) regressions += compare_with_baseline(result, &baseline[j]);
+		}
+	}
+
+	if (record) {
+		if (!write_baseline(baseline_path, results, SUITE_SCENARIO_COUNT)) {
+			fprintf(stderr, "bench: could not write %s\n", baseline_path);
+			return 1;
+		}
+		printf("baseline written to %s\n", baseline_path);
+	} else if (baseline_count >= 0) {
+		printf("%s\n", (regressions == 0) ? "no regressions against the baseline" : "FAILED: regressions against the baseline");
+	}
+	return regressions;
+}
+
+// ---- raster kernels ----
+
+short int RASTER_TEXTURE[TEXTURE_SIZE][TEXTURE_SIZE];
+short int RASTER_IMAGE[SCREEN_SIZE_Y * SCREEN_SIZE_X];
+short int RASTER_FRAMES_OUT[2][SCREEN_SIZE_Y * FRAME_BUFFER_STRIDE];
+
+// fills the test texture and image with the same random texels every run, using all 16 bits
+void init_raster_inputs() {
+	unsigned int seed = 12345;
+	int i;
+	for (i = 0; i < TEXTURE_SIZE * TEXTURE_SIZE; i++) {
+		seed = seed * 1103515245 + 12345;
+		RASTER_TEXTURE[i / TEXTURE_SIZE][i % TEXTURE_SIZE] = seed >> 16;
+	}
+	for (i = 0; i < SCREEN_SIZE_Y * SCREEN_SIZE_X; i++) {
+		seed = seed * 1103515245 + 12345;
+		RASTER_IMAGE[i] = seed >> 16;
+	}
+}
+
+// one frame's worth of each kernel, drawn into frame with the scalar version or the SIMD one.
+// fill_frame clears the screen, blit_frame copies a screen sized image, gather_frame draws a wall column of a
+// different size and light level in every screen column, and texture_frame covers the screen with the texture
+void fill_frame(short int* frame, bool scalar) {
+	int y;
+	for (y = 0; y < SCREEN_SIZE_Y; y++) {
+		short int* row = frame + y * FRAME_BUFFER_STRIDE;
+		if (scalar) fill_span_scalar(row, y, SCREEN_SIZE_X);
+		else fill_span(row, y, SCREEN_SIZE_X);
+	}
+}
+
+void blit_frame(short int* frame, bool scalar) {
+	int y;
+	for (y = 0; y < SCREEN_SIZE_Y; y++) {
+		short int* row = frame + y * FRAME_BUFFER_STRIDE;
+		if (scalar) blit_row_scalar(row, RASTER_IMAGE + y * SCREEN_SIZE_X, SCREEN_SIZE_X);
+		else blit_row(row, RASTER_IMAGE + y * SCREEN_SIZE_X, SCREEN_SIZE_X);
+	}
+}
+
+void texture_frame(short int* frame, bool scalar) {
+	int x, y;
+	for (y = 0; y + TEXTURE_SIZE <= SCREEN_SIZE_Y; y += TEXTURE_SIZE) {
+		for (x = 0; x + TEXTURE_SIZE <= SCREEN_SIZE_X; x += TEXTURE_SIZE) {
+			short int* corner = frame + y * FRAME_BUFFER_STRIDE + x;
+			if (scalar) blit_texture_scalar(corner, FRAME_BUFFER_STRIDE, RASTER_TEXTURE);
+			else blit_texture(corner, FRAME_BUFFER_STRIDE, RASTER_TEXTURE);
+		}
+	}
+}
+
+// clears both output frames to the same garbage
+void clear_raster_frames() {
+	memset(RASTER_FRAMES_OUT, 0x5A, sizeof(RASTER_FRAMES_OUT));
+}
+
+bool raster_frames_differ() {
+	return memcmp(RASTER_FRAMES_OUT[0], RASTER_FRAMES_OUT[1], sizeof(RASTER_FRAMES_OUT[0])) != 0;
+}
+
+// checks the kernels against the scalar versions on every span length up to 3 * 16 + 15 pixels from every
+// alignment, and the texture at every alignment.
+// Returns the number of failed checks
+int check_raster_kernels() {
+	int failures = 0;
+	int offset, count;
+
+	clear_raster_frames();
+	for (offset = 0; offset < 16; offset++) {
+		for (count = 0; count < 64; count++) {
+			short int* row0 = RASTER_FRAMES_OUT[0] + count * FRAME_BUFFER_STRIDE + offset;
+			short int* row1 = RASTER_FRAMES_OUT[1] + count * FRAME_BUFFER_STRIDE + offset;
+			fill_span_scalar(row0, count * 16 + offset, count);
+			fill_span(row1, count * 16 + offset, count);
+			blit_row_scalar(row0 + 2 * SCREEN_SIZE_X / 3, RASTER_IMAGE + offset * 7, count);
+			blit_row(row1 + 2 * SCREEN_SIZE_X / 3, RASTER_IMAGE + offset * 7, count);
+		}
+		if (raster_frames_differ()) {
+			printf("fill_span or blit_row differs at offset %d\n", offset);
+			failures++;
+		}
+	}
+
+	clear_raster_frames();
+	for (offset = 0; offset < 16; offset++) {
+		blit_texture_scalar(RASTER_FRAMES_OUT[0] + offset * FRAME_BUFFER_STRIDE + offset * 17, FRAME_BUFFER_STRIDE, RASTER_TEXTURE);
+		blit_texture(RASTER_FRAMES_OUT[1] + offset * FRAME_BUFFER_STRIDE + offset * 17, FRAME_BUFFER_STRIDE, RASTER_TEXTURE);
+	}
+	if (raster_frames_differ()) {
+		printf("blit_texture differs\n");
+		failures++;
+	}
+
+	return failures;
+}
+
+// draws RASTER_FRAMES frames with kernel_frame three times and returns the seconds the fastest run took
+double time_raster_frames(void (*kernel_frame)(short int*, bool), bool scalar) {
+	double best = 0;
+	int run, i;
+	kernel_frame(RASTER_FRAMES_OUT[0], scalar);
+
+	for (run = 0; run < 3; run++) {
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (i = 0; i < RASTER_FRAMES; i++) {
+			kernel_frame(RASTER_FRAMES_OUT[0], scalar);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		double seconds = elapsed_seconds(&start, &end);
+		if (run == 0 || seconds < best) best = seconds;
+	}
+	return best;
+}
+
+void report_raster_kernel(const char* name, void (*kernel_frame)(short int*, bool), int pixels_per_frame) {
+	double scalar_seconds = time_raster_frames(kernel_frame, true);
+	double seconds = time_raster_frames(kernel_frame, false);
+	double pixels = (double)pixels_per_frame * RASTER_FRAMES;
+	printf("%-20s %8.0f Mpixels/sec scalar %8.0f Mpixels/sec %s (%.2fx)\n", name, pixels / scalar_seconds / 1e6,
+		pixels / seconds / 1e6, RASTER_KERNELS, scalar_seconds / seconds);
+}
+
+int raster_kernels() {
+	init_shade_tables();
+	init_raster_inputs();
+
+	int failures = check_raster_kernels();
+	printf("raster kernels: %s, %s\n", RASTER_KERNELS, (failures == 0) ? "all match the scalar versions" : "MISMATCH");
+	if (failures != 0) return failures;
+
+	report_raster_kernel("fill_span", fill_frame, SCREEN_SIZE_X * SCREEN_SIZE_Y);
+	report_raster_kernel("blit_row", blit_frame, SCREEN_SIZE_X * SCREEN_SIZE_Y);
+	report_raster_kernel("blit_texture", texture_frame,
+		(SCREEN_SIZE_X / TEXTURE_SIZE) * (SCREEN_SIZE_Y / TEXTURE_SIZE) * TEXTURE_SIZE * TEXTURE_SIZE);
+	return 0;
+}
+
+// the rays draw_frame cast in the frames time_frames last timed
+long long timed_rays_cast = 0;
+
+// draws frames from (player_x, player_y), turning by one KEY press every frame, and returns the seconds taken
+double time_frames(int player_x, int player_y, int frames, int workers) {
+	int player_angle = 0;
+
+	// warm up caches and the worker threads before timing
+	int i;
+	for (i = 0; i < 16; i++) {
+		draw_frame_parallel(player_x, player_y, player_angle, workers);
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	timed_rays_cast = 0;
+	for (i = 0; i < frames; i++) {
+		draw_frame_parallel(player_x, player_y, player_angle, workers);
+		timed_rays_cast += FRAME_RAYS_CAST;
+		player_angle = wrap_angle(player_angle + 5);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return elapsed_seconds(&start, &end);
+}
+
+// scatters count sprites over the open cells of the map, pickups and enemies in turn
+void scatter_sprites(int count) {
+	clear_sprites();
+	unsigned int seed = 1;
+	while (SPRITE_COUNT < count) {
+		int x = maze_random(&seed) % MAP_SIZE_X, y = maze_random(&seed) % MAP_SIZE_Y;
+		if (MAP_DATA[x][y] == 0) {
+			add_sprite(x * 64 + 32, y * 64 + 32, SPRITE_COUNT % SPRITE_TEXTURE_COUNT);
+		}
+	}
+}
+
+int sprite_scaling() {
+	backend_init();
+	config_map();
+	init_render();
+
+	static const int counts[] = { 0, 25, 100, 200, 400, 800, MAX_SPRITES };
+	printf("%-8s %10s %10s %10s %10s %12s\n", "sprites", "frames/s", "drawn", "hidden", "off screen", "us/sprite");
+	double base_seconds = 0;
+	int i;
+	for (i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+		scatter_sprites(counts[i]);
+		long long drawn = 0, hidden = 0, offscreen = 0;
+		int frame, player_angle = 0;
+		for (frame = 0; frame < 64; frame++) {
+			draw_frame(SPRITE_BENCH_X, SPRITE_BENCH_Y, player_angle);
+		}
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (frame = 0; frame < SPRITE_BENCH_FRAMES; frame++) {
+			draw_frame(SPRITE_BENCH_X, SPRITE_BENCH_Y, player_angle);
+			drawn += SPRITE_FRAME.count;
+			hidden += SPRITE_FRAME.occluded;
+			offscreen += SPRITE_FRAME.offscreen;
+			player_angle = wrap_angle(player_angle + PLAYER_TURN_STEP);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		double seconds = elapsed_seconds(&start, &end);
+		if (counts[i] == 0) base_seconds = seconds;
+		// the time the sprites added to each frame, per sprite drawn
+		double sprite_us = (drawn > 0) ? (seconds - base_seconds) * 1e6 / drawn : 0;
+		printf("%-8d %10.1f %10.1f %10.1f %10.1f %12.2f\n", counts[i], SPRITE_BENCH_FRAMES / seconds,
+			(double)drawn / SPRITE_BENCH_FRAMES, (double)hidden / SPRITE_BENCH_FRAMES, (double)offscreen / SPRITE_BENCH_FRAMES, sprite_us);
+	}
+	clear_sprites();
+	return 0;
+}
+
+key_event_queue stress_queue;
+
+// the producer side of bench --input-queue. Every event's time is its number, its KEYs the low bits of it
+void* push_key_events(void* arg) {
+	unsigned int i;
+	for (i = 0; i < INPUT_QUEUE_EVENTS; i++) {
+		key_event event = { i, (int)(i & 0xF) };
+		while (!key_event_push(&stress_queue, event)) {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+bool stress_producer_done;
+
+// the producer side of the overflow check, which pushes like pushbutton_ISR without waiting for room
+void* push_latest_key_events(void* arg) {
+	unsigned int i;
+	for (i = 0; i < INPUT_QUEUE_EVENTS; i++) {
+		key_event event = { i, (int)(i & 0xF) };
+		key_event_push_latest(&stress_queue, event);
+	}
+	__atomic_store_n(&stress_producer_done, true, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+// pushes with key_event_push_latest from another thread while popping slower than it pushes. Events are lost,
+// but the ones that come out have to be in order and the last one has to be the last pushed. Returns the errors
+unsigned int input_queue_overflow() {
+	key_event_queue_init(&stress_queue);
+	stress_producer_done = false;
+	pthread_t producer;
+	if (pthread_create(&producer, NULL, push_latest_key_events, NULL) != 0) {
+		fprintf(stderr, "bench: could not start the producer thread\n");
+		return 1;
+	}
+
+	unsigned int errors = 0, popped = 0, next = 0;
+	bool done = false;
+	while (!done) {
+		// once the producer is done, an empty pop means everything it pushed has come out
+		done = __atomic_load_n(&stress_producer_done, __ATOMIC_ACQUIRE);
+		key_event event;
+		while (key_event_pop(&stress_queue, &event)) {
+			if (event.time_us < next || event.key_value != (int)(event.time_us & 0xF)) {
+				if (errors++ < 8) printf("overflow: got time %u keys %d after %u\n", event.time_us, event.key_value, next);
+			}
+			next = event.time_us + 1;
+			popped++;
+			sched_yield();
+		}
+	}
+	pthread_join(producer, NULL);
+
+	if (next != INPUT_QUEUE_EVENTS) {
+		printf("overflow: the last event out was %u, not %d\n", next - 1, INPUT_QUEUE_EVENTS - 1);
+		errors++;
+	}
+	printf("overflowing:  %u of %d events came out, in order, the last %u\n", popped, INPUT_QUEUE_EVENTS, next - 1);
+	return errors;
+}
+
+int input_queue_stress() {
+	key_event_queue_init(&stress_queue);
+	pthread_t producer;
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (pthread_create(&producer, NULL, push_key_events, NULL) != 0) {
+		fprintf(stderr, "bench: could not start the producer thread\n");
+		return 1;
+	}
+
+	// the events have to come out in the order they went in
+	unsigned int expected = 0, errors = 0, empty_polls = 0;
+	while (expected < INPUT_QUEUE_EVENTS) {
+		key_event event;
+		if (!key_event_pop(&stress_queue, &event)) {
+			// with fewer cores than threads the producer needs a turn
+			empty_polls++;
+			sched_yield();
+			continue;
+		}
+		if (event.time_us != expected || event.key_value != (int)(expected & 0xF)) {
+			if (errors++ < 8) printf("event %u: got time %u keys %d\n", expected, event.time_us, event.key_value);
+			expected = event.time_us;
+		}
+		expected++;
+	}
+	pthread_join(producer, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	key_event extra;
+	if (key_event_pop(&stress_queue, &extra)) errors++;
+	double seconds = elapsed_seconds(&start, &end);
+	printf("key events:   %d through a %d event queue in %.3f s (%.1f M events/sec), %u polls found it empty\n",
+		INPUT_QUEUE_EVENTS, KEY_EVENT_QUEUE_SIZE, seconds, INPUT_QUEUE_EVENTS / seconds / 1e6, empty_polls);
+	errors += input_queue_overflow();
+	printf("errors:       %u\n", errors);
+	return (errors == 0) ? 0 : 1;
+}
+
+// draws frames padded out to frame_ms of CPU time each and presents them with buffer_count buffers, swapping at
+// PRESENT_REFRESH_HZ, and returns the frames/sec presented
+double time_presented_frames(int buffer_count, double frame_ms) {
+	host_set_frame_buffers(buffer_count);
+	int player_angle = 0, i;
+
+	// the first few frames are presented before the buffers fill up, so they aren't timed
+	struct timespec start, end, now;
+	for (i = -PRESENT_BUFFERS_WARMUP; i < PRESENT_FRAMES; i++) {
+		if (i == 0) clock_gettime(CLOCK_MONOTONIC, &start);
+		struct timespec frame_start;
+		clock_gettime(CLOCK_MONOTONIC, &frame_start);
+		draw_frame(96, 96, player_angle);
+		do {
+			clock_gettime(CLOCK_MONOTONIC, &now);
+		} while (elapsed_seconds(&frame_start, &now) * 1e3 < frame_ms);
+		backend_swap_buffers();
+		player_angle = wrap_angle(player_angle + 5);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return PRESENT_FRAMES / elapsed_seconds(&start, &end);
+}
+
+// with two buffers every frame that misses a V-Sync waits for the next one, with three it only waits when
+// it is a whole refresh ahead
+int present_rates() {
+	backend_init();
+	config_map();
+	init_render();
+	host_set_vsync(PRESENT_REFRESH_HZ);
+
+	static const double frame_ms[] = { 10, 18, 20, 25, 30, 40 };
+	printf("%d Hz refresh, %d frames each\n", PRESENT_REFRESH_HZ, PRESENT_FRAMES);
+	printf("%-10s %14s %14s\n", "frame ms", "2 buffers fps", "3 buffers fps");
+	int i;
+	for (i = 0; i < (int)(sizeof(frame_ms) / sizeof(frame_ms[0])); i++) {
+		double double_buffered = time_presented_frames(2, frame_ms[i]);
+		double triple_buffered = time_presented_frames(3, frame_ms[i]);
+		printf("%-10.0f %14.1f %14.1f\n", frame_ms[i], double_buffered, triple_buffered);
+	}
+	return 0;
+}
+
+// ---- ray packets ----
+
+// the position of pose of a packet benchmark map: rooms of a maze, or around the middle of an open map
+void packet_bench_pose(int pose, int maze_size, int* player_x, int* player_y) {
+	if (maze_size > 0) {
+		player_state player;
+		maze_camera(pose * SUITE_ROOM_FRAMES, maze_size, &player);
+		*player_x = player.x;
+		*player_y = player.y;
+	} else {
+		*player_x = ((MAP_GRID.size_x / 2) << 6) + 21 + pose * 7;
+		*player_y = ((MAP_GRID.size_y / 2) << 6) + 40 - pose * 5;
+	}
+}
+
+// traces every angle from every pose, in packets or one ray at a time into hits[pose][angle], and returns the
+// seconds taken. For the built in map the poses are its start positions
+double trace_packet_bench(int maze_size, bool packets, ray_hit (*hits)[ANGLE_UNITS]) {
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	int pose, angle;
+	for (pose = 0; pose < PACKET_BENCH_POSES; pose++) {
+		int player_x, player_y;
+		if (maze_size < 0) {
+			player_x = PLAYER_START_X + (pose % 4) * 64 + pose;
+			player_y = PLAYER_START_Y + (pose / 4 % 4) * 64 + pose / 2;
+		} else {
+			packet_bench_pose(pose, maze_size, &player_x, &player_y);
+		}
+		if (packets) {
+			for (angle = 0; angle < ANGLE_UNITS; angle += RAY_PACKET_SIZE) {
+				trace_ray_packet(player_x, player_y, wrap_angle(angle + RAY_PACKET_SIZE - 1), &hits[pose][angle]);
+			}
+		} else {
+			for (angle = 0; angle < ANGLE_UNITS; angle++) {
+				trace_ray_fixed(player_x, player_y, wrap_angle(angle + RAY_PACKET_SIZE - 1 - 2 * (angle % RAY_PACKET_SIZE)), &hits[pose][angle]);
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return elapsed_seconds(&start, &end);
+}
+
+// the best of a few runs
+double best_packet_bench(int maze_size, bool packets, ray_hit (*hits)[ANGLE_UNITS]) {
+	double best = 1e9;
+	int run;
+	for (run = 0; run < 9; run++) {
+		double seconds = trace_packet_bench(maze_size, packets, hits);
+		if (seconds < best) best = seconds;
+	}
+	return best;
+}
+
+int packet_traversal() {
+	// maze size 0 is an open map, -1 the built in map
+	static const struct { const char* name; int maze_size; int open_size; } maps[] = {
+		{ "built in", -1, 0 },
+		{ "maze-256", 256, 0 },
+		{ "maze-4096", 4096, 0 },
+		{ "open-1024", 0, 1024 },
+	};
+	ray_hit (*packet_hits)[ANGLE_UNITS] = malloc(PACKET_BENCH_POSES * sizeof(*packet_hits));
+	ray_hit (*single_hits)[ANGLE_UNITS] = malloc(PACKET_BENCH_POSES * sizeof(*single_hits));
+
+	printf("packets of %d rays (%s)\n", RAY_PACKET_SIZE, RAY_PACKET_KERNELS);
+	printf("%-12s %14s %14s %9s %10s %11s\n", "map", "rays/s single", "rays/s packet", "speedup", "alone", "mismatches");
+	int failures = 0, i;
+	for (i = 0; i < (int)(sizeof(maps) / sizeof(maps[0])); i++) {
+		void* storage = NULL;
+		if (maps[i].maze_size < 0) {
+			config_map();
+			snapshot_map();
+		} else {
+			int size = (maps[i].maze_size > 0) ? maps[i].maze_size : maps[i].open_size;
+			storage = malloc(map_storage_size(size, size));
+			if (maps[i].maze_size > 0) {
+				build_maze(&MAP_GRID, size, 1, storage);
+			} else {
+				build_scaling_map(&MAP_GRID, size, storage);
+			}
+		}
+
+		double single = best_packet_bench(maps[i].maze_size, false, single_hits);
+		RAY_PACKET_COUNTS = true;
+		reset_packet_counts();
+		trace_packet_bench(maps[i].maze_size, true, packet_hits);
+		RAY_PACKET_COUNTS = false;
+		double single_rays = (double)RAY_PACKET_SINGLE_RAYS / (RAY_PACKETS_TRACED * RAY_PACKET_SIZE);
+		double packet = best_packet_bench(maps[i].maze_size, true, packet_hits);
+
+		// single_hits are in the same order as the lanes of the packets
+		int pose, angle, mismatches = 0;
+		for (pose = 0; pose < PACKET_BENCH_POSES; pose++) {
+			for (angle = 0; angle < ANGLE_UNITS; angle++) {
+				ray_hit* a = &packet_hits[pose][angle];
+				ray_hit* b = &single_hits[pose][angle];
+				if (a->distance != b->distance || a->cell_x != b->cell_x || a->cell_y != b->cell_y ||
+					a->face != b->face || a->texture_u != b->texture_u || a->steps != b->steps) {
+					mismatches++;
+				}
+			}
+		}
+		failures += mismatches;
+
+		int rays = PACKET_BENCH_POSES * ANGLE_UNITS;
+		printf("%-12s %14.0f %14.0f %8.2fx %9.1f%% %11d\n", maps[i].name, rays / single, rays / packet, single / packet, single_rays * 100, mismatches);
+		free(storage);
+	}
+
+	free(packet_hits);
+	free(single_hits);
+	return failures;
+}
+
+// ---- dynamic resolution ----
+
+// draws frames turning on the spot with a controller picking the column shift for a budget of budget_us, and
+// reports how many frames were drawn at each level, and how long they took
+void run_resolution_controller(unsigned int budget_us, double* frame_us) {
+	resolution_controller controller;
+	resolution_init(&controller, budget_us);
+	RENDER_COLUMN_SHIFT = 0;
+
+	int levels[MAX_COLUMN_SHIFT + 1] = { 0 };
+	int player_angle = 0, over_budget = 0, i;
+	double total_us = 0;
+	for (i = 0; i < RESOLUTION_BENCH_FRAMES; i++) {
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		draw_frame(96, 96, player_angle);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		frame_us[i] = elapsed_seconds(&start, &end) * 1e6;
+		total_us += frame_us[i];
+		if (frame_us[i] > budget_us) over_budget++;
+		levels[RENDER_COLUMN_SHIFT]++;
+		RENDER_COLUMN_SHIFT = resolution_update(&controller, (unsigned int)frame_us[i]);
+		player_angle = wrap_angle(player_angle + 5);
+	}
+	qsort(frame_us, RESOLUTION_BENCH_FRAMES, sizeof(double), compare_doubles);
+
+	printf("%-10u %7.1f%% %7.1f%% %7.1f%% %10.1f %10.1f %9.1f%%\n", budget_us,
+		levels[0] * 100.0 / RESOLUTION_BENCH_FRAMES, levels[1] * 100.0 / RESOLUTION_BENCH_FRAMES, levels[2] * 100.0 / RESOLUTION_BENCH_FRAMES,
+		total_us / RESOLUTION_BENCH_FRAMES, frame_us[RESOLUTION_BENCH_FRAMES * 99 / 100], over_budget * 100.0 / RESOLUTION_BENCH_FRAMES);
+}
+
+int dynamic_resolution() {
+	backend_init();
+	config_map();
+	config_sprites();
+	init_render();
+	// every frame casts all of its rays, as while the player walks
+	RAY_REUSE_ENABLED = false;
+
+	printf("%-8s %8s %12s %12s\n", "shift", "columns", "frames/sec", "us/frame");
+	double full_us = 0;
+	int shift;
+	for (shift = 0; shift <= MAX_COLUMN_SHIFT; shift++) {
+		RENDER_COLUMN_SHIFT = shift;
+		if (!parallel_output_matches(96, 96, RESOLUTION_BENCH_WORKERS)) {
+			fprintf(stderr, "bench: column shift %d with %d workers doesn't match draw_frame\n", shift, RESOLUTION_BENCH_WORKERS);
+			return 1;
+		}
+		double seconds = time_frames(96, 96, RESOLUTION_BENCH_FRAMES, 1);
+		if (shift == 0) full_us = seconds * 1e6 / RESOLUTION_BENCH_FRAMES;
+		printf("%-8d %8d %12.1f %12.1f\n", shift, SCREEN_SIZE_X >> shift, RESOLUTION_BENCH_FRAMES / seconds, seconds * 1e6 / RESOLUTION_BENCH_FRAMES);
+	}
+
+	// budgets from the full resolution frame time down to under the coarsest level's
+	static const int budget_percents[] = { 150, 100, 80, 60, 40 };
+	double* frame_us = malloc(RESOLUTION_BENCH_FRAMES * sizeof(double));
+	printf("\n%-10s %8s %8s %8s %10s %10s %10s\n", "budget us", "320", "160", "80", "avg us", "p99 us", "over");
+	int i;
+	for (i = 0; i < (int)(sizeof(budget_percents) / sizeof(budget_percents[0])); i++) {
+		run_resolution_controller((unsigned int)(full_us * budget_percents[i] / 100), frame_us);
+	}
+	free(frame_us);
+
+	RENDER_COLUMN_SHIFT = 0;
+	RAY_REUSE_ENABLED = true;
+	return 0;
+}
+
+// a pose off-centre in every open cell of the built in map, at BATCH_BENCH_ANGLES directions each
+int batch_bench_poses(batch_pose** poses) {
+	*poses = malloc(16 * 16 * BATCH_BENCH_ANGLES * sizeof(batch_pose));
+	int count = 0, cell_x, cell_y, i;
+	for (cell_x = 0; cell_x < 16; cell_x++) {
+		for (cell_y = 0; cell_y < 16; cell_y++) {
+			if (MAP_DATA[cell_x][cell_y] != 0) continue;
+			for (i = 0; i < BATCH_BENCH_ANGLES; i++) {
+				batch_pose pose = { (cell_x << 6) + 21, (cell_y << 6) + 40, i * ANGLE_UNITS / BATCH_BENCH_ANGLES };
+				(*poses)[count++] = pose;
+			}
+		}
+	}
+	return count;
+}
+
+// reads back the packed file of poses and returns true if every frame in it is the one draw_frame draws
+bool batch_output_matches(const batch_pose* poses, int count) {
+	FILE* file = fopen(BATCH_BENCH_FILE, "rb");
+	if (file == NULL) {
+		return false;
+	}
+	batch_packed_header header;
+	bool matches = fread(&header, sizeof(header), 1, file) == 1 && header.magic == BATCH_PACKED_MAGIC &&
+		header.frame_count == (unsigned int)count && header.width == SCREEN_SIZE_X && header.height == SCREEN_SIZE_Y;
+
+	static short int packed[SCREEN_SIZE_X * SCREEN_SIZE_Y];
+	int i, y;
+	for (i = 0; matches && i < count; i++) {
+		if (fread(packed, sizeof(packed), 1, file) != 1) {
+			matches = false;
+			break;
+		}
+		draw_frame_parallel(poses[i].x, poses[i].y, poses[i].angle, 1);
+		for (y = 0; y < SCREEN_SIZE_Y; y++) {
+			if (memcmp(packed + y * SCREEN_SIZE_X, FRAME_BUFFER_ADDR + y * FRAME_BUFFER_STRIDE, SCREEN_SIZE_X * sizeof(short int)) != 0) {
+				matches = false;
+			}
+		}
+	}
+	fclose(file);
+	return matches;
+}
+
+int batch_bench() {
+	backend_init();
+	config_map();
+	config_sprites();
+	init_render();
+
+	batch_pose* poses;
+	int count = batch_bench_poses(&poses);
+	if (!batch_render(poses, count, 4, BATCH_PACKED, BATCH_BENCH_FILE, NULL) || !batch_output_matches(poses, count)) {
+		fprintf(stderr, "bench: the batch renderer's frames in %s don't match draw_frame\n", BATCH_BENCH_FILE);
+		free(poses);
+		return 1;
+	}
+	remove(BATCH_BENCH_FILE);
+	printf("poses:       %d, every frame matches draw_frame\n\n", count);
+
+	static const int worker_counts[] = { 1, 2, 4 };
+	printf("%-8s %8s %10s %12s %16s\n", "workers", "cores", "seconds", "frames/sec", "frames/sec/core");
+	int i;
+	for (i = 0; i < (int)(sizeof(worker_counts) / sizeof(worker_counts[0])); i++) {
+		batch_stats stats;
+		batch_render(poses, count, worker_counts[i], BATCH_NONE, NULL, &stats);
+		printf("%-8d %8d %10.3f %12.1f %16.1f\n", stats.workers, stats.cores, stats.seconds, stats.frames_per_second, stats.frames_per_second_per_core);
+	}
+	free(poses);
+	return 0;
+}
+
+// the channels of an RGB565 colour scaled to 0 - 255, for bench --palette
+#define channel_red(color) ((((unsigned short)(color)) >> 11) << 3)
+#define channel_green(color) ((((color) >> 5) & 0x3F) << 2)
+#define channel_blue(color) (((color) & 0x1F) << 3)
+
+// draws every pose in RGB565 and in indexed colour, and adds up how many pixels differ, the total of their
+// channel differences (0 - 255 scale) and the largest one
+void compare_palette_frames(const batch_pose* poses, int count, long long* pixels, long long* differing, long long* total_error, int* max_error) {
+	static short int rgb_frame[SCREEN_SIZE_Y * FRAME_BUFFER_STRIDE];
+	*pixels = *differing = *total_error = 0;
+	*max_error = 0;
+	int i, x, y;
+	for (i = 0; i < count; i++) {
+		PALETTE_ENABLED = false;
+		draw_frame_parallel(poses[i].x, poses[i].y, poses[i].angle, 1);
+		memcpy(rgb_frame, FRAME_BUFFER_ADDR, sizeof(rgb_frame));
+		PALETTE_ENABLED = true;
+		draw_frame_parallel(poses[i].x, poses[i].y, poses[i].angle, 1);
+
+		for (y = 0; y < SCREEN_SIZE_Y; y++) {
+			for (x = 0; x < SCREEN_SIZE_X; x++) {
+				short int rgb = rgb_frame[y * FRAME_BUFFER_STRIDE + x], indexed = FRAME_BUFFER_ADDR[y * FRAME_BUFFER_STRIDE + x];
+				(*pixels)++;
+				if (rgb == indexed) continue;
+				int error = abs(channel_red(rgb) - channel_red(indexed)) + abs(channel_green(rgb) - channel_green(indexed)) +
+					abs(channel_blue(rgb) - channel_blue(indexed));
+				(*differing)++;
+				*total_error += error;
+				if (error > *max_error) *max_error = error;
+			}
+		}
+	}
+	PALETTE_ENABLED = false;
+}
+
+int palette_bench() {
+	backend_init();
+	config_map();
+	config_sprites();
+	init_render();
+	bool palette_enabled = PALETTE_ENABLED;
+
+	printf("palette:     %d texel colours\n", PALETTE_TEXEL_COLORS);
+
+	batch_pose* poses;
+	int count = batch_bench_poses(&poses);
+	long long pixels, differing, total_error;
+	int max_error;
+	// while the palette holds every texel colour the frames are the RGB565 ones, shaded or not, except for the mip
+	// levels, whose averaged texels are only near a palette colour
+	MIPMAPS_ENABLED = false;
+	int shading;
+	for (shading = 0; shading < 2; shading++) {
+		SHADING_ENABLED = (shading == 1);
+		compare_palette_frames(poses, count, &pixels, &differing, &total_error, &max_error);
+		if (PALETTE_TEXEL_COLORS < PALETTE_COLORS && differing != 0) {
+			fprintf(stderr, "bench: %lld %s pixels drawn from indexed textures don't match RGB565\n", differing,
+				shading ? "shaded" : "unshaded");
+			free(poses);
+			return 1;
+		}
+		printf("%-12s %lld of %lld pixels differ, without mipmaps\n", shading ? "shaded:" : "unshaded:", differing, pixels);
+	}
+	MIPMAPS_ENABLED = true;
+	compare_palette_frames(poses, count, &pixels, &differing, &total_error, &max_error);
+	printf("mipmaps:     %lld of %lld pixels differ (%.2f%%), by %.2f on average and %d at most (sum of channels, 0 - 255 each)\n",
+		differing, pixels, differing * 100.0 / pixels, differing ? (double)total_error / differing : 0.0, max_error);
+	free(poses);
+
+	// every frame casts all of its rays, as while the player walks, so both modes do the same ray casting
+	RAY_REUSE_ENABLED = false;
+	printf("\n%-18s %12s %12s %12s %12s\n", "frame", "frames/sec", "us/frame", "pixel bytes", "texel bytes");
+	int mode, standing;
+	for (mode = 0; mode < 2; mode++) {
+		PALETTE_ENABLED = (mode == 1);
+		for (standing = 0; standing < 2; standing++) {
+			double seconds;
+			if (standing) {
+				struct timespec start, end;
+				clock_gettime(CLOCK_MONOTONIC, &start);
+				int i;
+				for (i = 0; i < PALETTE_BENCH_FRAMES; i++) draw_frame_parallel(96, 96, 0, 1);
+				clock_gettime(CLOCK_MONOTONIC, &end);
+				seconds = elapsed_seconds(&start, &end);
+			} else {
+				seconds = time_frames(96, 96, PALETTE_BENCH_FRAMES, 1);
+			}
+			long long pixel_writes = 0;
+			int i;
+			for (i = 0; i < SCREEN_SIZE_X; i++) pixel_writes += COLUMN_PIXEL_WRITES[i];
+			// the bytes the compositor and sprites store down the columns of the last frame, and the bytes of the
+			// texels they read for them
+			long long pixel_bytes = pixel_writes * (int)sizeof(short int);
+			long long texel_bytes = pixel_writes * (PALETTE_ENABLED ? 1 : (int)sizeof(short int));
+			char name[32];
+			snprintf(name, sizeof(name), "%s %s", PALETTE_ENABLED ? "indexed" : "rgb565", standing ? "standing" : "turning");
+			printf("%-18s %12.1f %12.1f %12lld %12lld\n", name, PALETTE_BENCH_FRAMES / seconds,
+				seconds * 1e6 / PALETTE_BENCH_FRAMES, pixel_bytes, texel_bytes);
+		}
+	}
+	PALETTE_ENABLED = palette_enabled;
+	RAY_REUSE_ENABLED = true;
+	return 0;
+}
+
+// the bench --dirty-columns camera path from the start position: standing, turning on the spot, standing, walking
+// east down the corridor, then standing south of the long wall facing a sprite. Returns the number of poses
+int dirty_column_path(batch_pose* path) {
+	int count = 0, i;
+	for (i = 0; i < DIRTY_PATH_FRAMES; i++) path[count++] = (batch_pose){ PLAYER_START_X, PLAYER_START_Y, 0 };
+	for (i = 0; i < DIRTY_PATH_FRAMES; i++) path[count++] = (batch_pose){ PLAYER_START_X, PLAYER_START_Y, wrap_angle(5 * i) };
+	for (i = 0; i < DIRTY_PATH_FRAMES; i++) path[count++] = (batch_pose){ PLAYER_START_X, PLAYER_START_Y, wrap_angle(5 * DIRTY_PATH_FRAMES) };
+	for (i = 0; i < DIRTY_PATH_FRAMES; i++) path[count++] = (batch_pose){ PLAYER_START_X + 4 * i, PLAYER_START_Y, 0 };
+	for (i = 0; i < DIRTY_PATH_FRAMES; i++) path[count++] = (batch_pose){ SPRITE_BENCH_X, SPRITE_BENCH_Y, 0 };
+	return count;
+}
+
+// draws the path presenting with buffer_count buffers, with and without skipping columns, and returns true if every
+// frame is the same. The sprites are taken away half way through the last part, so the columns they covered have to
+// be drawn over
+bool skipped_frames_match(const batch_pose* path, int count, int buffer_count) {
+	static short int frames[5 * DIRTY_PATH_FRAMES][SCREEN_SIZE_Y * FRAME_BUFFER_STRIDE];
+	bool skipping = COLUMN_SKIPPING_ENABLED, matches = true;
+	int run, i;
+	for (run = 0; run < 2; run++) {
+		COLUMN_SKIPPING_ENABLED = (run == 1);
+		host_set_frame_buffers(buffer_count);
+		forget_drawn_frames();
+		config_sprites();
+		for (i = 0; i < count; i++) {
+			if (i == count - DIRTY_PATH_FRAMES / 2) clear_sprites();
+			draw_frame(path[i].x, path[i].y, path[i].angle);
+			if (run == 0) {
+				memcpy(frames[i], FRAME_BUFFER_ADDR, sizeof(frames[i]));
+			} else if (memcmp(frames[i], FRAME_BUFFER_ADDR, sizeof(frames[i])) != 0) {
+				matches = false;
+			}
+			backend_swap_buffers();
+		}
+	}
+	COLUMN_SKIPPING_ENABLED = skipping;
+	config_sprites();
+	return matches;
+}
+
+// draws frames poses of the path from first, presenting them with two buffers, and reports the frame rate and the
+// columns skipped per frame. Without and with skipping take turns three times, and the fastest run of each counts
+void time_dirty_columns(const char* name, const batch_pose* path, int first, int poses) {
+	bool skipping = COLUMN_SKIPPING_ENABLED;
+	double best[2] = { 0, 0 };
+	long long columns_skipped = 0, walls_skipped = 0;
+	int run;
+	for (run = 0; run < 6; run++) {
+		COLUMN_SKIPPING_ENABLED = (run % 2 == 1);
+		host_set_frame_buffers(2);
+		forget_drawn_frames();
+		columns_skipped = 0;
+		walls_skipped = 0;
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		int i;
+		for (i = 0; i < DIRTY_BENCH_FRAMES; i++) {
+			const batch_pose* pose = &path[first + i % poses];
+			draw_frame(pose->x, pose->y, pose->angle);
+			columns_skipped += FRAME_COLUMNS_SKIPPED;
+			walls_skipped += FRAME_WALLS_SKIPPED;
+			backend_swap_buffers();
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		double frames_per_second = DIRTY_BENCH_FRAMES / elapsed_seconds(&start, &end);
+		if (frames_per_second > best[run % 2]) best[run % 2] = frames_per_second;
+	}
+	printf("%-10s %12.1f %12.1f %12.1f %12.1f\n", name, best[0], best[1],
+		(double)columns_skipped / DIRTY_BENCH_FRAMES, (double)walls_skipped / DIRTY_BENCH_FRAMES);
+	COLUMN_SKIPPING_ENABLED = skipping;
+}
+
+int dirty_columns() {
+	backend_init();
+	config_map();
+	config_sprites();
+	init_render();
+
+	static batch_pose path[5 * DIRTY_PATH_FRAMES];
+	int count = dirty_column_path(path);
+	// with the indexed textures and at half and a quarter of the resolution as well
+	int buffer_count, variant;
+	for (variant = 0; variant < 4; variant++) {
+		PALETTE_ENABLED = (variant == 1);
+		RENDER_COLUMN_SHIFT = (variant >= 2) ? variant - 1 : 0;
+		for (buffer_count = 2; buffer_count <= 3; buffer_count++) {
+			if (!skipped_frames_match(path, count, buffer_count)) {
+				fprintf(stderr, "bench: skipping columns with %d buffers%s changes the frames drawn\n", buffer_count,
+					(variant == 1) ? " and the indexed textures" : (variant == 2) ? " at half resolution" :
+					(variant == 3) ? " at a quarter of the resolution" : "");
+				return 1;
+			}
+		}
+	}
+	PALETTE_ENABLED = false;
+	RENDER_COLUMN_SHIFT = 0;
+	printf("frames:      %d, the same with and without skipping columns\n\n", count);
+
+	// standing still, turning on the spot and walking back and forth in the corridor, and standing among the sprites
+	static batch_pose walk[2 * DIRTY_PATH_FRAMES];
+	int i;
+	for (i = 0; i < DIRTY_PATH_FRAMES; i++) {
+		walk[i] = path[3 * DIRTY_PATH_FRAMES + i];
+		walk[2 * DIRTY_PATH_FRAMES - 1 - i] = path[3 * DIRTY_PATH_FRAMES + i];
+	}
+	static batch_pose turn[ANGLE_UNITS / 5];
+	for (i = 0; i < ANGLE_UNITS / 5; i++) turn[i] = (batch_pose){ PLAYER_START_X, PLAYER_START_Y, 5 * i };
+
+	// frames/sec drawing every column and skipping them, and the columns skipped whole and without their walls per frame
+	printf("%-10s %12s %12s %12s %12s\n", "", "every column", "skipping", "skipped", "walls");
+	time_dirty_columns("standing", path, 0, 1);
+	time_dirty_columns("sprites", path, 4 * DIRTY_PATH_FRAMES, 1);
+	time_dirty_columns("turning", turn, 0, ANGLE_UNITS / 5);
+	time_dirty_columns("walking", walk, 0, 2 * DIRTY_PATH_FRAMES);
+	return 0;
+}
+
+// true if the pixels of frame and FRAME_BUFFER_ADDR that differ are all in far walls of FRAME_SLICES
+bool only_far_walls_differ(const short int* frame) {
+	int x, y;
+	for (x = 0; x < SCREEN_SIZE_X; x++) {
+		bool far = FRAME_SLICES.size[x] != INT_MAX && projected_slice_size(FRAME_SLICES.distance[x]) <= MIPMAP_FAR_WALL;
+		for (y = 0; y < SCREEN_SIZE_Y; y++) {
+			if (frame[y * FRAME_BUFFER_STRIDE + x] == FRAME_BUFFER_ADDR[y * FRAME_BUFFER_STRIDE + x]) continue;
+			if (!far || y < FRAME_SLICES.location[x] || y >= FRAME_SLICES.location[x] + FRAME_SLICES.size[x]) return false;
+		}
+	}
+	return true;
+}
+
+// marks the cache lines of wall textures the far walls of FRAME_SLICES read, in lines (a bit per line of
+// WALL_TEXTURES then WALL_TEXTURE_MIPS), as draw_wall_column reads them
+void mark_texture_lines(unsigned char* lines) {
+	int x;
+	for (x = 0; x < SCREEN_SIZE_X; x++) {
+		if (FRAME_SLICES.size[x] == INT_MAX || FRAME_SLICES.size[x] <= 0) continue;
+		int wall_size = projected_slice_size(FRAME_SLICES.distance[x]);
+		if (wall_size > MIPMAP_FAR_WALL) continue;
+		int mip = wall_mip_level(wall_size);
+		int texel_step = ((TEXTURE_SIZE >> mip) << 16) / wall_size;
+		int texel_v = (FRAME_SLICES.location[x] - (SCREEN_SIZE_Y - wall_size) / 2) * texel_step;
+		const short int* texels = wall_texel_column(wall_texture_slot(FRAME_SLICES.tile_type[x]), mip, FRAME_SLICES.texture_u[x]);
+
+		const char* base = (mip == 0) ? (const char*)WALL_TEXTURES : (const char*)WALL_TEXTURE_MIPS - sizeof(WALL_TEXTURES);
+		int first = (const char*)(texels + (texel_v >> 16)) - base;
+		int last = (const char*)(texels + ((texel_v + (FRAME_SLICES.size[x] - 1) * texel_step) >> 16)) - base;
+		int line;
+		for (line = first / CACHE_LINE; line <= last / CACHE_LINE; line++) lines[line / 8] |= 1 << (line % 8);
+	}
+}
+
+// draws the poses of path and returns the average change of the far wall pixels from one frame to the next
+// (sum of channels, 0 - 255 each) and the texture cache lines the far walls read per frame
+void follow_mipmap_path(const batch_pose* path, double* change, double* lines_read) {
+	static short int last_frame[SCREEN_SIZE_Y * FRAME_BUFFER_STRIDE];
+	static unsigned char lines[(sizeof(WALL_TEXTURES) + sizeof(WALL_TEXTURE_MIPS)) / CACHE_LINE / 8 + 1];
+	long long total_change = 0, far_pixels = 0, total_lines = 0;
+	int i, x, y;
+	for (i = 0; i < MIPMAP_PATH_FRAMES; i++) {
+		draw_frame_parallel(path[i].x, path[i].y, path[i].angle, 1);
+		memset(lines, 0, sizeof(lines));
+		mark_texture_lines(lines);
+		for (x = 0; x < (int)sizeof(lines); x++) total_lines += __builtin_popcount(lines[x]);
+
+		for (x = 0; i > 0 && x < SCREEN_SIZE_X; x++) {
+			if (FRAME_SLICES.size[x] == INT_MAX || projected_slice_size(FRAME_SLICES.distance[x]) > MIPMAP_FAR_WALL) continue;
+			for (y = FRAME_SLICES.location[x]; y < FRAME_SLICES.location[x] + FRAME_SLICES.size[x]; y++) {
+				short int now = FRAME_BUFFER_ADDR[y * FRAME_BUFFER_STRIDE + x], before = last_frame[y * FRAME_BUFFER_STRIDE + x];
+				total_change += abs(channel_red(now) - channel_red(before)) + abs(channel_green(now) - channel_green(before)) +
+					abs(channel_blue(now) - channel_blue(before));
+				far_pixels++;
+			}
+		}
+		memcpy(last_frame, FRAME_BUFFER_ADDR, sizeof(last_frame));
+	}
+	*change = far_pixels ? (double)total_change / far_pixels : 0;
+	*lines_read = (double)total_lines / MIPMAP_PATH_FRAMES;
+}
+
+int mipmap_bench() {
+	backend_init();
+	config_map();
+	config_sprites();
+	init_render();
+	// every frame is drawn whole, with every ray cast
+	COLUMN_SKIPPING_ENABLED = false;
+	RAY_REUSE_ENABLED = false;
+
+	batch_pose* poses;
+	int count = batch_bench_poses(&poses), i;
+	static short int full_size[SCREEN_SIZE_Y * FRAME_BUFFER_STRIDE];
+	for (i = 0; i < count; i++) {
+		MIPMAPS_ENABLED = false;
+		draw_frame_parallel(poses[i].x, poses[i].y, poses[i].angle, 1);
+		memcpy(full_size, FRAME_BUFFER_ADDR, sizeof(full_size));
+		MIPMAPS_ENABLED = true;
+		draw_frame_parallel(poses[i].x, poses[i].y, poses[i].angle, 1);
+		if (!only_far_walls_differ(full_size)) {
+			fprintf(stderr, "bench: mipmaps changed pixels outside the walls %d tall or less at %d %d %d\n", MIPMAP_FAR_WALL,
+				poses[i].x, poses[i].y, poses[i].angle);
+			free(poses);
+			return 1;
+		}
+	}
+	free(poses);
+	printf("poses:       %d, mipmaps only change walls %d pixels tall or less\n\n", count, MIPMAP_FAR_WALL);
+
+	// looking down the corridor from the start position, walking east a unit a frame, and turning a binary angle a frame
+	static batch_pose walk[MIPMAP_PATH_FRAMES], turn[MIPMAP_PATH_FRAMES];
+	for (i = 0; i < MIPMAP_PATH_FRAMES; i++) {
+		walk[i] = (batch_pose){ PLAYER_START_X + i, PLAYER_START_Y, 0 };
+		turn[i] = (batch_pose){ PLAYER_START_X, PLAYER_START_Y, wrap_angle(i - MIPMAP_PATH_FRAMES / 2) };
+	}
+	const batch_pose* paths[2] = { walk, turn };
+	const char* names[2] = { "walking", "turning" };
+
+	printf("%-10s %-9s %14s %14s %12s\n", "", "mipmaps", "far change", "far lines", "frames/sec");
+	int path, mode;
+	for (path = 0; path < 2; path++) {
+		for (mode = 0; mode < 2; mode++) {
+			MIPMAPS_ENABLED = (mode == 1);
+			double change, lines_read;
+			follow_mipmap_path(paths[path], &change, &lines_read);
+
+			struct timespec start, end;
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			int repeat;
+			for (repeat = 0; repeat < MIPMAP_REPEATS; repeat++) {
+				for (i = 0; i < MIPMAP_PATH_FRAMES; i++) draw_frame_parallel(paths[path][i].x, paths[path][i].y, paths[path][i].angle, 1);
+			}
+			clock_gettime(CLOCK_MONOTONIC, &end);
+			printf("%-10s %-9s %14.2f %14.1f %12.1f\n", names[path], MIPMAPS_ENABLED ? "on" : "off", change, lines_read,
+				MIPMAP_REPEATS * MIPMAP_PATH_FRAMES / elapsed_seconds(&start, &end));
+		}
+	}
+	MIPMAPS_ENABLED = true;
+	COLUMN_SKIPPING_ENABLED = true;
+	RAY_REUSE_ENABLED = true;
+	return 0;
+}
+
+int main(int argc, char** argv) {
+
+	if (argc > 1 && strcmp(argv[1], "--compare") == 0) {
+		config_map();
+		snapshot_map();
+		return compare_ray_casters() ? 0 : 1;
+	}
+	if (argc > 1 && strcmp(argv[1], "--suite") == 0) {
+		return (run_suite((argc > 2) ? argv[2] : SUITE_BASELINE, false) == 0) ? 0 : 1;
+	}
+	if (argc > 1 && strcmp(argv[1], "--suite-record") == 0) {
+		return (run_suite((argc > 2) ? argv[2] : SUITE_BASELINE, true) == 0) ? 0 : 1;
+	}
+	if (argc > 1 && strcmp(argv[1], "--raster") == 0) {
+		return (raster_kernels() == 0) ? 0 : 1;
+	}
+	if (argc > 1 && strcmp(argv[1], "--map-stream") == 0) {
+		return map_stream((argc > 2) ? argv[2] : "/tmp/bench.rmap");
+	}
+	if (argc > 1 && strcmp(argv[1], "--input-queue") == 0) {
+		return input_queue_stress();
+	}
+	if (argc > 1 && strcmp(argv[1], "--sprites") == 0) {
+		return sprite_scaling();
+	}
+	if (argc > 1 && strcmp(argv[1], "--present") == 0) {
+		return present_rates();
+	}
+	if (argc > 1 && strcmp(argv[1], "--packets") == 0) {
+		return (packet_traversal() == 0) ? 0 : 1;
+	}
+	if (argc > 1 && strcmp(argv[1], "--dynamic-resolution") == 0) {
+		return dynamic_resolution();
+	}
+	if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+		return batch_bench();
+	}
+	if (argc > 1 && strcmp(argv[1], "--palette") == 0) {
+		return palette_bench();
+	}
+	if (argc > 1 && strcmp(argv[1], "--dirty-columns") == 0) {
+		return dirty_columns();
+	}
+	if (argc > 1 && strcmp(argv[1], "--mipmaps") == 0) {
+		return mipmap_bench();
+	}
+	if (argc > 1 && strcmp(argv[1], "--map-scaling") == 0) {
+		return (map_scaling() == 0) ? 0 : 1;
+	}
+
+	int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+	int workers = (argc > 2) ? atoi(argv[2]) : 1;
+	if (frames <= 0 || workers <= 0) {
+		fprintf(stderr, "usage: %s [frames] [workers]\n", argv[0]);
+		return 1;
+	}
+
+	backend_init();
+	config_map();
+	config_sprites();
+	init_render();
+
+	int player_x = 96, player_y = 96;
+
+	if (workers > 1 && !parallel_output_matches(player_x, player_y, workers)) {
+		fprintf(stderr, "bench: draw_frame_parallel with %d workers doesn't match draw_frame\n", workers);
+		return 1;
+	}
+	// asking for more workers than the backend runs still draws every column
+	if (!parallel_output_matches(player_x, player_y, EXCESS_WORKERS)) {
+		fprintf(stderr, "bench: draw_frame_parallel with %d workers doesn't match draw_frame\n", EXCESS_WORKERS);
+		return 1;
+	}
+
+	int i;
+	double seconds = time_frames(player_x, player_y, frames, workers);
+	long long rays_cast = timed_rays_cast;
+	SHADING_ENABLED = false;
+	double unshaded_seconds = time_frames(player_x, player_y, frames, workers);
+	SHADING_ENABLED = true;
+	RAY_REUSE_ENABLED = false;
+	double recast_seconds = time_frames(player_x, player_y, frames, workers);
+	RAY_REUSE_ENABLED = true;
+
+#ifdef RAYCAST_FIXED_POINT
+	printf("ray caster:  fixed point\n");
+#else
+	printf("ray caster:  double\n");
+#endif
+	printf("raster:      %s\n", RASTER_KERNELS);
+	printf("workers:     %d\n", workers);
+	printf("frames:      %d\n", frames);
+	printf("time:        %.3f s\n", seconds);
+	printf("frames/sec:  %.1f\n", frames / seconds);
+	printf("unshaded:    %.1f frames/sec\n", frames / unshaded_seconds);
+	printf("rays cast:   %.1f per frame, without reusing rays %.1f frames/sec\n", (double)rays_cast / frames, frames / recast_seconds);
+	// from the frames that cast every column, the others reuse most of their rays
+	printf("rays/sec:    %.0f, without reusing rays\n", (double)frames * SCREEN_SIZE_X / recast_seconds);
+
+	// the pixels of a frame drawn whole, as skipped columns and walls would hide overdraw. Before the compositor,
+	// the main loop cleared the screen, filled the ceiling and floor with two rectangles, then drew the wall slices
+	// over them
+	bool skipping = COLUMN_SKIPPING_ENABLED;
+	COLUMN_SKIPPING_ENABLED = false;
+	RAY_REUSE_ENABLED = false;
+	draw_frame_parallel(player_x, player_y, 0, workers);
+	COLUMN_SKIPPING_ENABLED = skipping;
+	RAY_REUSE_ENABLED = true;
+	long long pixel_writes = 0, wall_pixels = 0;
+	for (i = 0; i < SCREEN_SIZE_X; i++) {
+		pixel_writes += COLUMN_PIXEL_WRITES[i];
+		if (FRAME_SLICES.size[i] != INT_MAX) wall_pixels += FRAME_SLICES.size[i];
+	}
+	printf("pixel writes: %lld per frame (%.2f per pixel), clearing and filling first would be %lld\n", pixel_writes,
+		(double)pixel_writes / (SCREEN_SIZE_X * SCREEN_SIZE_Y), 2LL * SCREEN_SIZE_X * SCREEN_SIZE_Y + wall_pixels);
+
+	return 0;
+}
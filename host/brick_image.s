@@ -0,0 +1,4 @@
+.data
+.global BRICK_IMAGE
+BRICK_IMAGE: .incbin "textures/brick.bin"
+.section .note.GNU-stack,"",%progbits
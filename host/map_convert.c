@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../raycast-core/map_grid.h"
+#include "../raycast-core/map_file.h"
+#include "maze.h"
+
+// Converts an image map to a binary map file (see raycast-core/map_file.h). Each pixel is one cell, x to the
+// right and y down, the same way round as map.PNG. White pixels are open cells. Every other colour is a wall,
+// with tile types numbered from 1 in the order the colours first appear, scanning rows from the top.
+// Images are binary PPM (P6) or PGM (P5), convert other formats first, e.g. convert map.png map.ppm
+// usage: map_convert <image> <map file>
+//        map_convert --maze <size> <seed> <map file>   writes a synthetic size x size maze instead (see maze.h)
+
+#define MAX_TILE_TYPES 255
+
+// reads the next number of a PNM header, skipping whitespace and comments
+int read_header_number(FILE* file) {
+	int c = fgetc(file);
+	while (c == '#' || c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+		if (c == '#') {
+			while (c != '\n' && c != EOF) c = fgetc(file);
+		}
+		c = fgetc(file);
+	}
+
+	int value = -1;
+	while (c >= '0' && c <= '9') {
+		value = ((value < 0) ? 0 : value * 10) + (c - '0');
+		c = fgetc(file);
+	}
+	return value;
+}
+
+// writes a size x size maze to path
+int write_maze(int size, unsigned int seed, const char* path) {
+	map_grid map;
+	void* storage = malloc(map_storage_size(size, size));
+	if (storage == NULL || !build_maze(&map, size, seed, storage)) {
+		fprintf(stderr, "map_convert: mazes can be 3 x 3 to %d x %d cells\n", MAP_MAX_SIZE, MAP_MAX_SIZE);
+		return 1;
+	}
+	if (!map_write_file(&map, path)) {
+		fprintf(stderr, "map_convert: could not write %s\n", path);
+		return 1;
+	}
+	free(storage);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc == 5 && strcmp(argv[1], "--maze") == 0) {
+		return write_maze(atoi(argv[2]), strtoul(argv[3], NULL, 10), argv[4]);
+	}
+	if (argc != 3) {
+		fprintf(stderr, "usage: %s <image.ppm|image.pgm> <map file>\n       %s --maze <size> <seed> <map file>\n", argv[0], argv[0]);
+		return 1;
+	}
+
+	FILE* image = fopen(argv[1], "rb");
+	if (image == NULL) {
+		fprintf(stderr, "map_convert: could not open %s\n", argv[1]);
+		return 1;
+	}
+
+	char magic[2];
+	int channels = 0;
+	if (fread(magic, 1, 2, image) == 2 && magic[0] == 'P') {
+		if (magic[1] == '6') channels = 3;
+		if (magic[1] == '5') channels = 1;
+	}
+	int width = read_header_number(image);
+	int height = read_header_number(image);
+	int max_value = read_header_number(image);
+	if (channels == 0 || width <= 0 || height <= 0 || max_value != 255) {
+		fprintf(stderr, "map_convert: %s is not an 8 bit binary PPM or PGM\n", argv[1]);
+		return 1;
+	}
+
+	map_grid map;
+	void* storage = malloc(map_storage_size(width, height));
+	if (storage == NULL || !map_init(&map, width, height, storage)) {
+		fprintf(stderr, "map_convert: maps can be at most %d x %d cells\n", MAP_MAX_SIZE, MAP_MAX_SIZE);
+		return 1;
+	}
+
+	// colours seen so far, packed 0xRRGGBB. The tile type is the index + 1
+	unsigned int colours[MAX_TILE_TYPES];
+	int colour_count = 0;
+
+	unsigned char* row = malloc(width * channels);
+	int x, y;
+	for (y = 0; y < height; y++) {
+		if (fread(row, channels, width, image) != (size_t)width) {
+			fprintf(stderr, "map_convert: %s is truncated\n", argv[1]);
+			return 1;
+		}
+		for (x = 0; x < width; x++) {
+			unsigned char* pixel = &row[x * channels];
+			unsigned int colour = (channels == 3) ? (pixel[0] << 16) | (pixel[1] << 8) | pixel[2] : pixel[0] * 0x010101;
+			if (colour == 0xFFFFFF) {
+				continue;
+			}
+
+			int tile_type = 0;
+			while (tile_type < colour_count && colours[tile_type] != colour) tile_type++;
+			if (tile_type == colour_count) {
+				if (colour_count == MAX_TILE_TYPES) {
+					fprintf(stderr, "map_convert: more than %d wall colours\n", MAX_TILE_TYPES);
+					return 1;
+				}
+				colours[colour_count++] = colour;
+				printf("tile type %d: #%06X\n", colour_count, colour);
+			}
+			map_set_cell(&map, x, y, tile_type + 1);
+		}
+	}
+	fclose(image);
+
+	map_build_pyramid(&map);
+	if (!map_write_file(&map, argv[2])) {
+		fprintf(stderr, "map_convert: could not write %s\n", argv[2]);
+		return 1;
+	}
+	printf("%s: %d x %d cells\n", argv[2], width, height);
+	return 0;
+}
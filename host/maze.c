@@ -0,0 +1,74 @@
+#include <stdlib.h>
+
+#include "maze.h"
+
+unsigned int maze_random(unsigned int* seed) {
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 8;
+}
+
+bool build_maze(map_grid* map, int size, unsigned int seed, void* storage) {
+	if (size < 3 || !map_init(map, size, size, storage)) {
+		return false;
+	}
+
+	int x, y;
+	for (x = 0; x < size; x++) {
+		for (y = 0; y < size; y++) map_set_cell(map, x, y, 1);
+	}
+
+	// rooms are numbered (x / 2) * rooms + y / 2. An even size leaves a wall two cells thick on the far sides
+	int rooms = (size - 1) / 2;
+	int* stack = malloc(sizeof(int) * rooms * rooms);
+	unsigned char* visited = calloc(rooms * rooms, 1);
+	if (stack == NULL || visited == NULL) {
+		free(stack);
+		free(visited);
+		return false;
+	}
+
+	static const int STEP_X[4] = { 1, -1, 0, 0 };
+	static const int STEP_Y[4] = { 0, 0, 1, -1 };
+
+	int depth = 0;
+	stack[depth++] = 0;
+	visited[0] = 1;
+	map_set_cell(map, 1, 1, 0);
+	while (depth > 0) {
+		int room = stack[depth - 1];
+		int room_x = room / rooms, room_y = room % rooms;
+
+		// pick one of the unvisited neighbours at random, or go back if there are none
+		int choices[4], choice_count = 0, direction;
+		for (direction = 0; direction < 4; direction++) {
+			int next_x = room_x + STEP_X[direction], next_y = room_y + STEP_Y[direction];
+			if (next_x >= 0 && next_x < rooms && next_y >= 0 && next_y < rooms && !visited[next_x * rooms + next_y]) {
+				choices[choice_count++] = direction;
+			}
+		}
+		if (choice_count == 0) {
+			depth--;
+			continue;
+		}
+		direction = choices[maze_random(&seed) % choice_count];
+		int next_x = room_x + STEP_X[direction], next_y = room_y + STEP_Y[direction];
+
+		// open the wall between the rooms and the next room itself
+		map_set_cell(map, 2 * room_x + 1 + STEP_X[direction], 2 * room_y + 1 + STEP_Y[direction], 0);
+		map_set_cell(map, 2 * next_x + 1, 2 * next_y + 1, 0);
+		visited[next_x * rooms + next_y] = 1;
+		stack[depth++] = next_x * rooms + next_y;
+	}
+	free(stack);
+	free(visited);
+
+	// walls between two rooms are at one odd and one even coordinate inside the outer wall
+	for (x = 1; x < 2 * rooms; x++) {
+		for (y = 1 + (x & 1); y < 2 * rooms; y += 2) {
+			if (maze_random(&seed) % MAZE_LOOP_CHANCE == 0) map_set_cell(map, x, y, 0);
+		}
+	}
+
+	map_build_pyramid(map);
+	return true;
+}
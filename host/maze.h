@@ -0,0 +1,21 @@
+#ifndef MAZE_H
+#define MAZE_H
+
+#include "../raycast-core/map_grid.h"
+
+// Synthetic mazes of any size, for benchmarks and test maps. Cells at odd x and odd y are rooms, everything
+// else starts as wall, and a depth first search from room (1, 1) knocks down the walls between rooms into a
+// maze with one path between any two rooms. Then 1 in MAZE_LOOP_CHANCE of the walls left between two rooms
+// are knocked down too, which adds loops and longer views down the corridors.
+// The same size and seed always give the same maze.
+
+#define MAZE_LOOP_CHANCE 8
+
+// lays out a size x size maze in storage (map_storage_size(size, size) bytes, see map_init) and builds its
+// pyramid. Returns false if the size is too big or too small, or memory runs out
+bool build_maze(map_grid* map, int size, unsigned int seed, void* storage);
+
+// the next number from a maze seed, a linear congruential generator
+unsigned int maze_random(unsigned int* seed);
+
+#endif // MAZE_H
@@ -0,0 +1,103 @@
+#include "input.h"
+
+key_event_queue KEY_EVENTS;
+
+void key_event_queue_init(key_event_queue* queue) {
+	queue->head = 0;
+	queue->tail = 0;
+	queue->overflow_seq = 0;
+	queue->overflow_taken = 0;
+}
+
+// an event written to the overflow is newer than everything in the queue, so nothing more goes in the queue
+// until the consumer has taken it
+static bool overflow_waiting(key_event_queue* queue) {
+	return queue->overflow_seq != __atomic_load_n(&queue->overflow_taken, __ATOMIC_ACQUIRE);
+}
+
+bool key_event_push(key_event_queue* queue, key_event event) {
+	unsigned int head = queue->head;
+	if (overflow_waiting(queue) || head - __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE) == KEY_EVENT_QUEUE_SIZE) {
+		return false;
+	}
+	queue->events[head & (KEY_EVENT_QUEUE_SIZE - 1)] = event;
+	// the event is written before the consumer can see it
+	__atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+void key_event_push_latest(key_event_queue* queue, key_event event) {
+	if (key_event_push(queue, event)) return;
+
+	// the consumer reading the overflow sees overflow_seq odd or changed if this write overlaps its read
+	unsigned int seq = queue->overflow_seq;
+	__atomic_store_n(&queue->overflow_seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	queue->overflow = event;
+	__atomic_store_n(&queue->overflow_seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+// takes the overflow the producer wrote as overflow_seq seq, if the consumer hasn't taken it yet and the producer
+// isn't writing over it
+static bool take_overflow(key_event_queue* queue, unsigned int seq, key_event* event) {
+	if (seq == queue->overflow_taken || (seq & 1) != 0) return false;
+	*event = queue->overflow;
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	if (__atomic_load_n(&queue->overflow_seq, __ATOMIC_RELAXED) != seq) return false;
+	__atomic_store_n(&queue->overflow_taken, seq, __ATOMIC_RELEASE);
+	return true;
+}
+
+bool key_event_pop(key_event_queue* queue, key_event* event) {
+	// the overflow is newer than every event pushed before it was written. Reading overflow_seq first means the
+	// queue is seen with all of those in it, so the overflow is only taken once they are gone
+	unsigned int seq = __atomic_load_n(&queue->overflow_seq, __ATOMIC_ACQUIRE);
+	unsigned int tail = queue->tail;
+	if (__atomic_load_n(&queue->head, __ATOMIC_ACQUIRE) == tail) {
+		return take_overflow(queue, seq, event);
+	}
+	*event = queue->events[tail & (KEY_EVENT_QUEUE_SIZE - 1)];
+	// the event is read before the producer can write over it
+	__atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+void simulation_init(simulation* sim, unsigned int now_us) {
+	sim->key_value = 0;
+	sim->next_tick_us = now_us;
+	sim->has_pending = false;
+	sim->ticks = 0;
+}
+
+// times wrap around, so they are compared by their difference
+#define time_reached(now, time) ((int)((now) - (time)) >= 0)
+
+int simulation_advance(simulation* sim, player_state* player, key_event_queue* queue, unsigned int now_us) {
+	int ticks = 0;
+	while (time_reached(now_us, sim->next_tick_us)) {
+		if (ticks == SIM_MAX_TICKS) {
+			// too far behind to catch up, carry on from now
+			sim->next_tick_us = now_us + SIM_TICK_US;
+			break;
+		}
+
+		// apply every KEY change up to the time of this tick
+		while (sim->has_pending || key_event_pop(queue, &sim->pending)) {
+			if (!time_reached(sim->next_tick_us, sim->pending.time_us)) {
+				sim->has_pending = true;
+				break;
+			}
+			sim->key_value = sim->pending.key_value;
+			sim->has_pending = false;
+		}
+
+#ifdef RECORD_KEYS
+		record_keys(sim->key_value);
+#endif
+		player_apply_keys(player, sim->key_value);
+		sim->next_tick_us += SIM_TICK_US;
+		sim->ticks++;
+		ticks++;
+	}
+	return ticks;
+}
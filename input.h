@@ -0,0 +1,82 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+
+#include "player.h"
+
+// KEY changes go from whatever reads the KEYs to the main loop through KEY_EVENTS, a ring with one producer and
+// one consumer that neither side locks. The producer is pushbutton_ISR on the board when built with
+// KEY_INTERRUPTS, backend_poll_input otherwise, and a thread standing in for the interrupt on the host (see
+// backend_start_input). The consumer is the main loop, which feeds the events to a fixed timestep simulation,
+// so the player moves at the same speed whatever the frame rate and the ISR never touches PLAYER.
+
+// must be a power of two
+#define KEY_EVENT_QUEUE_SIZE 64
+
+// the simulation ticks SIM_TICKS_PER_SECOND times a second, turning or moving the player one step per tick
+// a KEY is held (see player_apply_keys)
+#define SIM_TICKS_PER_SECOND 60
+#define SIM_TICK_US (1000000 / SIM_TICKS_PER_SECOND)
+// ticks simulation_advance runs at most, when frames fall further behind than this the time is dropped
+#define SIM_MAX_TICKS 8
+
+typedef struct key_event {
+	// backend_time_us when the KEYs changed
+	unsigned int time_us;
+	// the KEYs held from then on, in the format of the KEY data register
+	int key_value;
+} key_event;
+
+typedef struct key_event_queue {
+	key_event events[KEY_EVENT_QUEUE_SIZE];
+	// head counts the events pushed and is only written by the producer, tail counts the events popped and
+	// is only written by the consumer. Both wrap around, head - tail is the number of events queued
+	unsigned int head;
+	unsigned int tail;
+	// the newest event key_event_push_latest couldn't fit in the queue. Everything pushed after it replaces it
+	// here until the consumer takes it, once it has emptied the queue. overflow_seq counts the writes twice, it's
+	// odd while one is under way, and overflow_taken is the overflow_seq the consumer last took
+	key_event overflow;
+	unsigned int overflow_seq;
+	unsigned int overflow_taken;
+} key_event_queue;
+
+typedef struct simulation {
+	// the KEYs held, as of the last event applied
+	int key_value;
+	// when the next tick is due, in backend_time_us
+	unsigned int next_tick_us;
+	// an event popped from the queue that isn't due yet
+	key_event pending;
+	bool has_pending;
+	// ticks run since simulation_init
+	int ticks;
+} simulation;
+
+// the KEY changes not yet seen by the main loop
+extern key_event_queue KEY_EVENTS;
+
+// empties the queue. Only while neither side is using it
+void key_event_queue_init(key_event_queue* queue);
+
+// adds an event to the queue, returns false and drops it if the queue is full (or the overflow holds an event
+// the consumer hasn't taken yet). Producer only, safe from an ISR
+bool key_event_push(key_event_queue* queue, key_event event);
+
+// adds an event to the queue, or when it can't, writes it over the overflow. The events in between are lost but
+// the consumer still ends up with the KEYs held last. Producer only, safe from an ISR
+void key_event_push_latest(key_event_queue* queue, key_event event);
+
+// takes the oldest event off the queue, or the overflow once the queue is empty. Returns false if there is
+// neither. Consumer only
+bool key_event_pop(key_event_queue* queue, key_event* event);
+
+// starts a simulation with its first tick due at now_us and no KEYs held
+void simulation_init(simulation* sim, unsigned int now_us);
+
+// runs every tick due by now_us on player, each with the KEYs held at the time of the tick according to the
+// events in queue. Returns the number of ticks run. With RECORD_KEYS, logs the KEYs of every tick (see record_keys)
+int simulation_advance(simulation* sim, player_state* player, key_event_queue* queue, unsigned int now_us);
+
+#endif // INPUT_H
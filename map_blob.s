@@ -0,0 +1,8 @@
+.section .rodata
+.global MAP_BLOB
+.global MAP_BLOB_SIZE
+.align 12
+MAP_BLOB: .incbin "C:/Users/User/Desktop/test/maps/maze.rmap"
+MAP_BLOB_END:
+.align 2
+MAP_BLOB_SIZE: .word MAP_BLOB_END - MAP_BLOB
@@ -0,0 +1,50 @@
+#include <stdio.h>
+
+#include "player.h"
+#include "raycast-core/raycast.h"
+#include "raycast-core/trig_tables.h"
+#include "backend/backend.h"
+
+void player_apply_keys(player_state* player, int key_value) {
+	if (key_value == 1) {
+		player->angle = wrap_angle(player->angle - PLAYER_TURN_STEP);
+	} else if (key_value == 8) {
+		player->angle = wrap_angle(player->angle + PLAYER_TURN_STEP);
+	} else if (key_value == 4) {
+		move_player(player, PLAYER_MOVE_STEP);
+	} else if (key_value == 2) {
+		move_player(player, -PLAYER_MOVE_STEP);
+	}
+}
+
+void move_player(player_state* player, int step) {
+#ifdef RAYCAST_FIXED_POINT
+	// divide rather than shift, to truncate like the conversion from double does
+	player->y = ((long long)player->y * TABLE_ONE - (long long)step * fixed_sin(player->angle)) / TABLE_ONE;
+	player->x = ((long long)player->x * TABLE_ONE + (long long)step * fixed_cos(player->angle)) / TABLE_ONE;
+#else
+	player->y = player->y - step * sind(angle_to_degrees(player->angle));
+	player->x = player->x + step * cosd(angle_to_degrees(player->angle));
+#endif
+}
+
+// the KEYs being recorded, and the frames they have been held for
+int recorded_key_value = 0;
+int recorded_frames = 0;
+
+void record_keys(int key_value) {
+	if (key_value != recorded_key_value) {
+		record_keys_end();
+		recorded_key_value = key_value;
+	}
+	recorded_frames++;
+}
+
+void record_keys_end(void) {
+	if (recorded_frames > 0) {
+		char line[32];
+		snprintf(line, sizeof(line), "%d %d\n", recorded_key_value, recorded_frames);
+		backend_log(line);
+	}
+	recorded_frames = 0;
+}
@@ -0,0 +1,35 @@
+#ifndef PLAYER_H
+#define PLAYER_H
+
+// where the player is, in unit coordinates, and the binary angle they face (see raycast.h)
+typedef struct player_state {
+	int x;
+	int y;
+	int angle;
+} player_state;
+
+// binary angle units turned, and unit coordinates moved, per simulation tick a KEY is held (see input.h)
+#define PLAYER_TURN_STEP 5
+#define PLAYER_MOVE_STEP 8
+
+// where the player starts
+#define PLAYER_START_X 96
+#define PLAYER_START_Y 96
+#define PLAYER_START_ANGLE 0
+
+// moves or turns the player by one simulation tick of key_value, in the format of the KEY data register.
+// KEY0 turns right, KEY3 turns left, KEY2 moves forward and KEY1 moves back. Combinations of keys do nothing.
+// Replaying the same keys from the same state always gives the same path, so key scripts (see backend/host.h)
+// work as camera traces
+void player_apply_keys(player_state* player, int key_value);
+
+// moves the player step unit coordinates in the direction they face, backwards if step is negative
+void move_player(player_state* player, int step);
+
+// logs key_value as a key script through backend_log, one "<key value> <frame count>" line every time the KEYs
+// change, so a session played on the board can be replayed on the host. Call once per simulation tick, then
+// record_keys_end to log the last line
+void record_keys(int key_value);
+void record_keys_end(void);
+
+#endif // PLAYER_H
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "profile.h"
+
+#ifdef PROFILE
+
+static const char* STAGE_NAMES[PROFILE_STAGES] = { "input", "stream", "snapshot", "cast", "floor", "composite", "sprites", "swap", "frame" };
+
+profile_frame PROFILE_RING[PROFILE_RING_FRAMES];
+// the slot being filled in, and the number of frames ended since profile_init
+int profile_current = 0;
+int profile_frames = 0;
+
+void profile_init(void) {
+	backend_profile_clock_init();
+	memset(PROFILE_RING, 0, sizeof(PROFILE_RING));
+	profile_current = 0;
+	profile_frames = 0;
+}
+
+void profile_add_ticks(profile_stage stage, unsigned int ticks) {
+	__atomic_fetch_add(&PROFILE_RING[profile_current].ticks[stage], ticks, __ATOMIC_RELAXED);
+}
+
+void profile_count(profile_counter counter, unsigned int amount) {
+	__atomic_fetch_add(&PROFILE_RING[profile_current].counts[counter], amount, __ATOMIC_RELAXED);
+}
+
+void profile_end_frame(void) {
+	profile_frames++;
+	profile_current = (profile_current + 1) % PROFILE_RING_FRAMES;
+	memset(&PROFILE_RING[profile_current], 0, sizeof(profile_frame));
+
+	if (profile_frames % PROFILE_REPORT_FRAMES == 0) {
+		profile_report();
+	}
+}
+
+// ticks in tenths of a microsecond, or tenths of 1000 cycles when the clock counts cycles
+static unsigned long long tenths(unsigned long long ticks) {
+	unsigned int rate = backend_profile_tick_rate();
+	return (rate != 0) ? ticks * 10000000ULL / rate : ticks / 100;
+}
+
+void profile_report(void) {
+	// the frames in the ring that have ended, the slot being filled in isn't one of them
+	int frames = (profile_frames < PROFILE_RING_FRAMES - 1) ? profile_frames : PROFILE_RING_FRAMES - 1;
+	if (frames == 0) {
+		return;
+	}
+	int first = (profile_current - frames + PROFILE_RING_FRAMES) % PROFILE_RING_FRAMES;
+
+	char line[128];
+	snprintf(line, sizeof(line), "profile: last %d frames, %s\n%-10s %9s %9s %9s\n", frames,
+		(backend_profile_tick_rate() != 0) ? "us" : "1000 cycles", "stage", "min", "avg", "p99");
+	backend_log(line);
+
+	unsigned int ticks[PROFILE_RING_FRAMES];
+	int stage, i, j;
+	for (stage = 0; stage < PROFILE_STAGES; stage++) {
+		// sorted, for the p99
+		unsigned long long total = 0;
+		for (i = 0; i < frames; i++) {
+			unsigned int value = PROFILE_RING[(first + i) % PROFILE_RING_FRAMES].ticks[stage];
+			total += value;
+			for (j = i; j > 0 && ticks[j - 1] > value; j--) ticks[j] = ticks[j - 1];
+			ticks[j] = value;
+		}
+		int p99 = (frames * 99 + 99) / 100 - 1;
+
+		unsigned long long min = tenths(ticks[0]), avg = tenths(total / frames), high = tenths(ticks[p99]);
+		snprintf(line, sizeof(line), "%-10s %7llu.%llu %7llu.%llu %7llu.%llu\n", STAGE_NAMES[stage],
+			min / 10, min % 10, avg / 10, avg % 10, high / 10, high % 10);
+		backend_log(line);
+	}
+
+	unsigned long long counts[PROFILE_COUNTERS] = { 0 };
+	int counter;
+	for (i = 0; i < frames; i++) {
+		for (counter = 0; counter < PROFILE_COUNTERS; counter++) {
+			counts[counter] += PROFILE_RING[(first + i) % PROFILE_RING_FRAMES].counts[counter];
+		}
+	}
+	// per ray counts in hundredths
+	unsigned long long rays = (counts[COUNTER_RAYS] != 0) ? counts[COUNTER_RAYS] : 1;
+	unsigned long long steps = counts[COUNTER_STEPS] * 100 / rays, skips = counts[COUNTER_BLOCK_SKIPS] * 100 / rays;
+	snprintf(line, sizeof(line), "rays/frame %llu, steps/ray %llu.%02llu, block skips/ray %llu.%02llu, pixels/frame %llu, skipped columns/frame %llu\n",
+		counts[COUNTER_RAYS] / frames, steps / 100, steps % 100, skips / 100, skips % 100, counts[COUNTER_PIXELS] / frames,
+		counts[COUNTER_SKIPPED_COLUMNS] / frames);
+	backend_log(line);
+}
+
+#endif // PROFILE
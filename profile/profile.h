@@ -0,0 +1,80 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "../backend/backend.h"
+
+// Frame profiler. Compiled in when PROFILE is defined (make PROFILE=1 on the host), otherwise every macro
+// here expands to nothing and the engine is built exactly as without it.
+// Stages of the frame are timed between PROFILE_BEGIN and PROFILE_END with the backend's profiling clock
+// (see backend_profile_ticks), and counters such as the steps every ray takes through the grid are added up with
+// PROFILE_COUNT. Each frame's timings and counts go into one slot of a ring of PROFILE_RING_FRAMES frames, and
+// every PROFILE_REPORT_FRAMES frames profile_end_frame sends the min / average / p99 of each stage over the ring
+// to backend_log (the JTAG UART on the board, stdout on the host).
+// With several render workers, the cast, floor and composite stages add up the time of every worker.
+
+#define PROFILE_RING_FRAMES 256
+#define PROFILE_REPORT_FRAMES 256
+
+typedef enum profile_stage {
+	STAGE_INPUT,		// reading the KEYs and moving the player
+	STAGE_STREAM,		// backend_stream_map
+	STAGE_SNAPSHOT,		// snapshot_map
+	STAGE_CAST,			// casting the rays
+	STAGE_FLOOR,		// cast_floor_rows
+	STAGE_COMPOSITE,	// drawing the columns
+	STAGE_SPRITES,		// culling, sorting and drawing the sprites
+	STAGE_SWAP,			// backend_swap_buffers, waiting for V-Sync on the board
+	STAGE_FRAME,		// the whole frame
+	PROFILE_STAGES
+} profile_stage;
+
+typedef enum profile_counter {
+	COUNTER_RAYS,
+	COUNTER_STEPS,			// steps the rays took through the grid
+	COUNTER_BLOCK_SKIPS,	// empty blocks of the map pyramid the rays jumped across
+	COUNTER_PIXELS,			// pixels written by the compositor
+	COUNTER_SKIPPED_COLUMNS,	// columns the compositor left as they were (see frame_history in render/render.h)
+	PROFILE_COUNTERS
+} profile_counter;
+
+#ifdef PROFILE
+
+// one frame of the ring. Stage times are in profiling clock ticks
+typedef struct profile_frame {
+	unsigned int ticks[PROFILE_STAGES];
+	unsigned int counts[PROFILE_COUNTERS];
+} profile_frame;
+
+// starts the profiling clock and clears the ring
+void profile_init(void);
+
+// adds ticks to stage, and amount to counter, in the current frame. Safe to call from several workers at once
+void profile_add_ticks(profile_stage stage, unsigned int ticks);
+void profile_count(profile_counter counter, unsigned int amount);
+
+// moves to the next slot of the ring, and logs a summary every PROFILE_REPORT_FRAMES frames
+void profile_end_frame(void);
+
+// logs the min / average / p99 of every stage and the average of every counter over the frames in the ring
+void profile_report(void);
+
+#define PROFILE_INIT() profile_init()
+#define PROFILE_BEGIN(stage) unsigned int profile_start_##stage = backend_profile_ticks()
+#define PROFILE_END(stage) profile_add_ticks(stage, backend_profile_ticks() - profile_start_##stage)
+#define PROFILE_COUNT(counter, amount) profile_count(counter, amount)
+#define PROFILE_END_FRAME() profile_end_frame()
+// code that only runs in profiled builds, such as counting in a local
+#define PROFILE_ONLY(statement) statement
+
+#else
+
+#define PROFILE_INIT() ((void)0)
+#define PROFILE_BEGIN(stage) ((void)0)
+#define PROFILE_END(stage) ((void)0)
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#define PROFILE_END_FRAME() ((void)0)
+#define PROFILE_ONLY(statement)
+
+#endif // PROFILE
+
+#endif // PROFILE_H
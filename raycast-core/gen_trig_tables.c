@@ -0,0 +1,46 @@
+#include <stdio.h>
+
+#include "raycast.h"
+#include "trig_tables.h"
+
+// Generates trig_tables.c on the host. Run again (make tables) whenever SCREEN_SIZE_X or FOV changes.
+// usage: gen_trig_tables > trig_tables.c
+
+// rounds to 10.22, saturating at INT_MAX / -INT_MAX
+int to_fixed(double value) {
+	double scaled = value * TABLE_ONE;
+	if (scaled >= INT_MAX) return INT_MAX;
+	if (scaled <= -INT_MAX) return -INT_MAX;
+	return (int)lround(scaled);
+}
+
+void print_table(const char* name, int size, double (*function)(int)) {
+	printf("const int %s[%d] = {", name, size);
+	int i;
+	for (i = 0; i < size; i++) {
+		printf("%s%d,", (i % 8 == 0) ? "\n\t" : " ", to_fixed(function(i)));
+	}
+	printf("\n};\n\n");
+}
+
+double table_cos(int angle) { return cosd(angle_to_degrees(angle)); }
+double table_sec(int angle) { return 1 / fabs(cosd(angle_to_degrees(angle))); }
+double table_fishbowl(int column) { return cosd(angle_to_degrees(column - HALF_FOV_UNITS)); }
+
+int main(void) {
+
+	// ANGLE_UNITS is hard coded so it can size arrays, make sure it still matches RAY_ANGLE_INC
+	if (fabs(ANGLE_UNITS * RAY_ANGLE_INC - 360.0) > 1e-9) {
+		fprintf(stderr, "gen_trig_tables: ANGLE_UNITS must be 360 / RAY_ANGLE_INC = %f\n", 360.0 / RAY_ANGLE_INC);
+		return 1;
+	}
+
+	printf("// generated by gen_trig_tables.c, do not edit\n\n");
+	printf("#include \"trig_tables.h\"\n\n");
+
+	print_table("COS_TABLE", ANGLE_UNITS, table_cos);
+	print_table("SEC_TABLE", ANGLE_UNITS, table_sec);
+	print_table("FISHBOWL_TABLE", SCREEN_SIZE_X, table_fishbowl);
+
+	return 0;
+}
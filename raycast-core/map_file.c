@@ -0,0 +1,94 @@
+#include <stdio.h>
+
+#include "map_file.h"
+
+// the offsets of the bit planes and tile chunks in a map file of this size
+static void map_file_layout(int size_x, int size_y, map_file_header* header);
+
+bool map_attach(map_grid* map, const void* blob, unsigned int file_size) {
+	const map_file_header* header = blob;
+	if (file_size < sizeof(map_file_header) || header->magic != MAP_FILE_MAGIC || header->version != MAP_FILE_VERSION) {
+		return false;
+	}
+	if (header->block_shift != MAP_BLOCK_SHIFT || header->chunk_shift != MAP_CHUNK_SHIFT) {
+		return false;
+	}
+	if (header->size_x <= 0 || header->size_y <= 0 || header->size_x > MAP_MAX_SIZE || header->size_y > MAP_MAX_SIZE) {
+		return false;
+	}
+
+	// the layout is fixed by the map size, so a file that doesn't match it is corrupt
+	map_file_header expected;
+	map_file_layout(header->size_x, header->size_y, &expected);
+	if (header->bits_offset != expected.bits_offset || header->tiles_offset != expected.tiles_offset ||
+		header->file_size != expected.file_size || header->level_count != expected.level_count || file_size < expected.file_size) {
+		return false;
+	}
+
+	// lay the planes out the way map_init does, but in the blob instead of cleared storage
+	const unsigned char* bytes = blob;
+	map_grid attached;
+	attached.size_x = header->size_x;
+	attached.size_y = header->size_y;
+	attached.level_count = map_level_sizes(header->size_x, header->size_y, attached.levels);
+	attached.chunks_x = (header->size_x + MAP_CHUNK_SIZE - 1) >> MAP_CHUNK_SHIFT;
+	attached.chunks_y = (header->size_y + MAP_CHUNK_SIZE - 1) >> MAP_CHUNK_SHIFT;
+	attached.stream_first_x = attached.stream_first_y = 0;
+	attached.stream_last_x = attached.chunks_x;
+	attached.stream_last_y = attached.chunks_y;
+	attached.read_only = true;
+
+	unsigned int* bits = (unsigned int*)(bytes + header->bits_offset);
+	int level;
+	for (level = 0; level < attached.level_count; level++) {
+		attached.levels[level].bits = bits;
+		bits += attached.levels[level].size_x * attached.levels[level].words_y;
+	}
+	attached.tile_type = (unsigned char*)(bytes + header->tiles_offset);
+
+	map_changed(&attached);
+
+	*map = attached;
+	return true;
+}
+
+bool map_write_file(const map_grid* map, const char* path) {
+	FILE* file = fopen(path, "wb");
+	if (file == NULL) {
+		return false;
+	}
+
+	map_file_header header;
+	map_file_layout(map->size_x, map->size_y, &header);
+
+	// the planes are contiguous in map_init's storage, from level 0
+	static const unsigned char padding[MAP_FILE_ALIGN];
+	size_t bits_size = map_bits_size(map->size_x, map->size_y);
+	size_t tiles_size = (size_t)map->chunks_x * map->chunks_y * MAP_CHUNK_BYTES;
+
+	fwrite(&header, sizeof(header), 1, file);
+	fwrite(padding, 1, header.bits_offset - sizeof(header), file);
+	fwrite(map->levels[0].bits, 1, bits_size, file);
+	fwrite(padding, 1, header.tiles_offset - header.bits_offset - bits_size, file);
+	fwrite(map->tile_type, 1, tiles_size, file);
+
+	bool ok = !ferror(file);
+	return fclose(file) == 0 && ok;
+}
+
+static void map_file_layout(int size_x, int size_y, map_file_header* header) {
+	map_level levels[MAP_MAX_LEVELS];
+	size_t bits_size = map_bits_size(size_x, size_y);
+	size_t chunks = (size_t)((size_x + MAP_CHUNK_SIZE - 1) >> MAP_CHUNK_SHIFT) * ((size_y + MAP_CHUNK_SIZE - 1) >> MAP_CHUNK_SHIFT);
+
+	header->magic = MAP_FILE_MAGIC;
+	header->version = MAP_FILE_VERSION;
+	header->size_x = size_x;
+	header->size_y = size_y;
+	header->level_count = map_level_sizes(size_x, size_y, levels);
+	header->block_shift = MAP_BLOCK_SHIFT;
+	header->chunk_shift = MAP_CHUNK_SHIFT;
+	header->bits_offset = MAP_FILE_ALIGN;
+	header->tiles_offset = (header->bits_offset + bits_size + MAP_FILE_ALIGN - 1) / MAP_FILE_ALIGN * MAP_FILE_ALIGN;
+	header->file_size = header->tiles_offset + chunks * MAP_CHUNK_BYTES;
+}
@@ -0,0 +1,43 @@
+#ifndef MAP_FILE_H
+#define MAP_FILE_H
+
+#include <stdbool.h>
+
+#include "map_grid.h"
+
+// Binary map files hold a map_grid exactly as the ray casters read it, so loading one is pointing MAP_GRID
+// at it: mmap on the host, a read-only blob linked into the program on the board (map_blob.s).
+// Layout, all little endian:
+//   map_file_header, padded to MAP_FILE_ALIGN bytes
+//   the pyramid bit planes, level 0 first, as laid out by map_init
+//   padding to MAP_FILE_ALIGN bytes, then the tile type chunks, each MAP_CHUNK_BYTES
+// The chunks start on a page boundary, so a mapped file can page chunks in and out one at a time.
+// Files are written by map_write_file, see host/map_convert.c to make one from an image.
+
+#define MAP_FILE_MAGIC 0x50414d52	// "RMAP"
+#define MAP_FILE_VERSION 1
+#define MAP_FILE_ALIGN 4096
+
+typedef struct map_file_header {
+	unsigned int magic;
+	unsigned int version;
+	int size_x;
+	int size_y;
+	int level_count;
+	// MAP_BLOCK_SHIFT and MAP_CHUNK_SHIFT of the writer, they must match the reader's
+	int block_shift;
+	int chunk_shift;
+	// offsets from the start of the file
+	unsigned int bits_offset;
+	unsigned int tiles_offset;
+	unsigned int file_size;
+} map_file_header;
+
+// points map at a map file already in memory (file_size bytes at blob, MAP_FILE_ALIGN aligned), without
+// copying it. The map is read_only. Returns false if the blob isn't a map file this build can read
+bool map_attach(map_grid* map, const void* blob, unsigned int file_size);
+
+// writes map to path as a map file. Returns false on I/O errors
+bool map_write_file(const map_grid* map, const char* path);
+
+#endif // MAP_FILE_H
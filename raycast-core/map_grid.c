@@ -0,0 +1,107 @@
+#include <string.h>
+
+#include "map_grid.h"
+
+map_grid MAP_GRID;
+
+// the last generation given to a map, see map_changed
+unsigned int map_generations = 0;
+
+int map_level_sizes(int size_x, int size_y, map_level levels[MAP_MAX_LEVELS]) {
+	int level = 0;
+	while (level < MAP_MAX_LEVELS) {
+		levels[level].size_x = size_x;
+		levels[level].size_y = size_y;
+		levels[level].words_y = (size_y + 31) / 32;
+		level++;
+
+		// stop once a block covers the whole map, it would always have a wall in it
+		if (size_x <= MAP_BLOCK_SIZE && size_y <= MAP_BLOCK_SIZE) break;
+		size_x = (size_x + MAP_BLOCK_SIZE - 1) >> MAP_BLOCK_SHIFT;
+		size_y = (size_y + MAP_BLOCK_SIZE - 1) >> MAP_BLOCK_SHIFT;
+	}
+	return level;
+}
+
+size_t map_bits_size(int size_x, int size_y) {
+	map_level levels[MAP_MAX_LEVELS];
+	int level_count = map_level_sizes(size_x, size_y, levels);
+
+	size_t size = 0;
+	int level;
+	for (level = 0; level < level_count; level++) {
+		size += (size_t)levels[level].size_x * levels[level].words_y * sizeof(unsigned int);
+	}
+	return size;
+}
+
+size_t map_storage_size(int size_x, int size_y) {
+	size_t chunks_x = (size_x + MAP_CHUNK_SIZE - 1) >> MAP_CHUNK_SHIFT;
+	size_t chunks_y = (size_y + MAP_CHUNK_SIZE - 1) >> MAP_CHUNK_SHIFT;
+	return map_bits_size(size_x, size_y) + chunks_x * chunks_y * MAP_CHUNK_BYTES;
+}
+
+bool map_init(map_grid* map, int size_x, int size_y, void* storage) {
+	if (size_x <= 0 || size_y <= 0 || size_x > MAP_MAX_SIZE || size_y > MAP_MAX_SIZE) {
+		return false;
+	}
+	memset(storage, 0, map_storage_size(size_x, size_y));
+
+	map->size_x = size_x;
+	map->size_y = size_y;
+	map->level_count = map_level_sizes(size_x, size_y, map->levels);
+	map->chunks_x = (size_x + MAP_CHUNK_SIZE - 1) >> MAP_CHUNK_SHIFT;
+	map->chunks_y = (size_y + MAP_CHUNK_SIZE - 1) >> MAP_CHUNK_SHIFT;
+	map->stream_first_x = map->stream_first_y = 0;
+	map->stream_last_x = map->chunks_x;
+	map->stream_last_y = map->chunks_y;
+	map->read_only = false;
+
+	// the bit planes go first to keep them word aligned, then the tile types
+	unsigned int* bits = storage;
+	int level;
+	for (level = 0; level < map->level_count; level++) {
+		map->levels[level].bits = bits;
+		bits += map->levels[level].size_x * map->levels[level].words_y;
+	}
+	map->tile_type = (unsigned char*)bits;
+	map_changed(map);
+	return true;
+}
+
+void map_set_cell(map_grid* map, int x, int y, int tile_type) {
+	map_level* cells = &map->levels[0];
+	unsigned int* word = &cells->bits[x * cells->words_y + (y >> 5)];
+
+	map->tile_type[map_tile_index(map, x, y)] = tile_type;
+	if (tile_type != 0) {
+		*word |= 1u << (y & 31);
+	} else {
+		*word &= ~(1u << (y & 31));
+	}
+}
+
+void map_build_pyramid(map_grid* map) {
+	int level;
+	for (level = 1; level < map->level_count; level++) {
+		map_level* blocks = &map->levels[level];
+		map_level* below = &map->levels[level - 1];
+		memset(blocks->bits, 0, blocks->size_x * blocks->words_y * sizeof(unsigned int));
+
+		// a block is solid if any of the blocks it covers in the level below is
+		int x, y;
+		for (x = 0; x < below->size_x; x++) {
+			for (y = 0; y < below->size_y; y++) {
+				if ((below->bits[x * below->words_y + (y >> 5)] >> (y & 31)) & 1) {
+					int block_x = x >> MAP_BLOCK_SHIFT, block_y = y >> MAP_BLOCK_SHIFT;
+					blocks->bits[block_x * blocks->words_y + (block_y >> 5)] |= 1u << (block_y & 31);
+				}
+			}
+		}
+	}
+	map_changed(map);
+}
+
+void map_changed(map_grid* map) {
+	map->generation = ++map_generations;
+}
@@ -0,0 +1,121 @@
+#ifndef MAP_GRID_H
+#define MAP_GRID_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// The map the ray casters trace against: a bit-packed occupancy grid, a byte tile type per cell, and a
+// pyramid of coarser occupancy grids used to skip across empty space.
+// Level 0 of the pyramid has a bit per cell. Every level above it has a bit per block of
+// MAP_BLOCK_SIZE x MAP_BLOCK_SIZE blocks of the level below, set when any cell in the block is a wall.
+// When the ray is in an empty block it jumps straight to where it leaves the block, so a ray crossing a large
+// open area takes a handful of steps instead of one per cell.
+// Distances are 16.16 grid cells in the fixed point ray caster, so maps can be up to MAP_MAX_SIZE cells a side.
+// Tile types are stored in MAP_CHUNK_SIZE x MAP_CHUNK_SIZE chunks, 4 KB each, so a map file can be mapped into
+// memory and have the chunks away from the player paged out (see map_file.h).
+
+#define MAP_BLOCK_SHIFT 2
+#define MAP_BLOCK_SIZE (1 << MAP_BLOCK_SHIFT)
+#define MAP_MAX_LEVELS 7
+#define MAP_MAX_SIZE 4096
+
+#define MAP_CHUNK_SHIFT 6
+#define MAP_CHUNK_SIZE (1 << MAP_CHUNK_SHIFT)
+#define MAP_CHUNK_BYTES (MAP_CHUNK_SIZE * MAP_CHUNK_SIZE)
+
+// the tile type of walls outside the streamed chunks, see map_grid.stream_first_x
+#define MAP_UNSTREAMED_TILE_TYPE 1
+
+// one level of the occupancy pyramid. bit (y & 31) of bits[x * words_y + (y >> 5)] is block (x, y)
+typedef struct map_level {
+	int size_x;
+	int size_y;
+	int words_y;
+	unsigned int* bits;
+} map_level;
+
+typedef struct map_grid {
+	int size_x;
+	int size_y;
+	int level_count;
+	map_level levels[MAP_MAX_LEVELS];
+	// chunks_x * chunks_y chunks, see map_tile_index. 0 for open cells
+	unsigned char* tile_type;
+	int chunks_x;
+	int chunks_y;
+	// the chunks of tile types that are kept in memory, from stream_first to stream_last - 1 in x and y.
+	// All of them unless the backend streams the map. Walls outside them are MAP_UNSTREAMED_TILE_TYPE, so
+	// rays stopping far away never page in chunks; the occupancy pyramid is always all there
+	int stream_first_x;
+	int stream_first_y;
+	int stream_last_x;
+	int stream_last_y;
+	// true when the map is a prebuilt map file (see map_attach) that must not be changed
+	bool read_only;
+	// changes every time anything the rays can see changes, see map_changed. No two maps share a generation
+	unsigned int generation;
+} map_grid;
+
+// the map the ray casters trace against
+extern map_grid MAP_GRID;
+
+// an upper bound on map_storage_size(size_x, size_y) that can size static buffers
+#define MAP_STORAGE_BOUND(size_x, size_y) \
+	(((size_x) + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE * (((size_y) + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE) * MAP_CHUNK_BYTES + \
+	 (size_x) * (((size_y) + 31) / 32) * 8 + 256)
+
+// index of cell (x, y) in map->tile_type. Chunks are stored x major, and cells within a chunk too
+#define map_tile_index(map, x, y) \
+	((((x) >> MAP_CHUNK_SHIFT) * (map)->chunks_y + ((y) >> MAP_CHUNK_SHIFT)) * MAP_CHUNK_BYTES + \
+	 ((x) & (MAP_CHUNK_SIZE - 1)) * MAP_CHUNK_SIZE + ((y) & (MAP_CHUNK_SIZE - 1)))
+
+// true when cell (x, y) of MAP_GRID is a wall. x and y must be inside the map
+#define map_cell_solid(x, y) \
+	((MAP_GRID.levels[0].bits[(x) * MAP_GRID.levels[0].words_y + ((y) >> 5)] >> ((y) & 31)) & 1)
+
+// the tile type of cell (x, y) of map, see stream_first_x. x and y must be inside the map
+#define map_tile_type(map, x, y) \
+	(((x) >> MAP_CHUNK_SHIFT) >= (map)->stream_first_x && ((x) >> MAP_CHUNK_SHIFT) < (map)->stream_last_x && \
+	 ((y) >> MAP_CHUNK_SHIFT) >= (map)->stream_first_y && ((y) >> MAP_CHUNK_SHIFT) < (map)->stream_last_y ? \
+	 (map)->tile_type[map_tile_index(map, x, y)] : MAP_UNSTREAMED_TILE_TYPE)
+
+// the number of bytes of storage map_init needs for a map of this size
+size_t map_storage_size(int size_x, int size_y);
+
+// lays out an empty size_x x size_y map in storage, which must be map_storage_size bytes and 4 byte aligned.
+// returns false if the map is bigger than MAP_MAX_SIZE
+bool map_init(map_grid* map, int size_x, int size_y, void* storage);
+
+// fills in the size of every level of a size_x x size_y map, and returns the number of levels
+int map_level_sizes(int size_x, int size_y, map_level levels[MAP_MAX_LEVELS]);
+
+// the number of bytes of bit planes in front of the tile types in map_init's storage
+size_t map_bits_size(int size_x, int size_y);
+
+// sets the tile type of a cell and its level 0 occupancy bit. Call map_build_pyramid when done
+void map_set_cell(map_grid* map, int x, int y, int tile_type);
+
+// rebuilds the coarse levels of the pyramid from level 0
+void map_build_pyramid(map_grid* map);
+
+// gives map a new generation, so anything remembered about what the rays hit in it is thrown away. map_init,
+// map_build_pyramid and map_attach call it, and so must anything else that changes the tile types rays can see,
+// such as moving the streamed chunks
+void map_changed(map_grid* map);
+
+// returns the shift (a multiple of MAP_BLOCK_SHIFT) of the largest empty pyramid block around cell (x, y) of
+// MAP_GRID, or 0 if the cell's smallest block has a wall in it. x and y must be inside the map
+static inline int map_empty_block_shift(int x, int y) {
+	int level, shift = 0;
+	for (level = 1; level < MAP_GRID.level_count; level++) {
+		map_level* blocks = &MAP_GRID.levels[level];
+		int block_x = x >> (level * MAP_BLOCK_SHIFT), block_y = y >> (level * MAP_BLOCK_SHIFT);
+		if ((blocks->bits[block_x * blocks->words_y + (block_y >> 5)] >> (block_y & 31)) & 1) {
+			break;
+		}
+		shift = level * MAP_BLOCK_SHIFT;
+	}
+	return shift;
+}
+
+#endif // MAP_GRID_H
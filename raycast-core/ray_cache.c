@@ -0,0 +1,89 @@
+#include <string.h>
+
+#include "ray_cache.h"
+#include "map_grid.h"
+#include "ray_packet.h"
+#include "../profile/profile.h"
+
+bool packet_uncached(ray_cache* cache, int player_angle, int first_column);
+void cast_packet_cached(ray_cache* cache, int player_x, int player_y, int player_angle, int first_column, frame_slices* slices);
+
+void ray_cache_init(ray_cache* cache) {
+	memset(cache, 0, sizeof(ray_cache));
+	// stamp 0 is never used, so no angle starts out cached
+	cache->stamp = 1;
+}
+
+void ray_cache_begin_frame(ray_cache* cache, int player_x, int player_y) {
+	if (player_x != cache->player_x || player_y != cache->player_y || MAP_GRID.generation != cache->map_generation) {
+		cache->player_x = player_x;
+		cache->player_y = player_y;
+		cache->map_generation = MAP_GRID.generation;
+		cache->stamp++;
+		if (cache->stamp == 0) {
+			// after wrapping around, stamps from the last time round could look current
+			memset(cache->cast_stamp, 0, sizeof(cache->cast_stamp));
+			cache->stamp = 1;
+		}
+	}
+}
+
+int cast_frame_columns_cached(ray_cache* cache, int player_x, int player_y, int player_angle, int first_column, int last_column, frame_slices* slices) {
+	int cast = 0;
+	int i;
+	for (i = first_column; i < last_column; i++) {
+		int angle = column_ray_angle(player_angle, i);
+		ray_hit* hit = &cache->hits[angle];
+		bool cached = cache->cast_stamp[angle] == cache->stamp;
+#ifdef RAYCAST_FIXED_POINT
+		if (!cached && RAY_PACKETS_ENABLED && i + RAY_PACKET_SIZE <= last_column && packet_uncached(cache, player_angle, i)) {
+			cast_packet_cached(cache, player_x, player_y, player_angle, i, slices);
+			cast += RAY_PACKET_SIZE;
+			i += RAY_PACKET_SIZE - 1;
+			continue;
+		}
+#endif
+		if (!cached) {
+#ifdef RAYCAST_FIXED_POINT
+			trace_ray_fixed(player_x, player_y, angle, hit);
+#else
+			trace_ray(player_x, player_y, angle, hit);
+#endif
+			cache->cast_stamp[angle] = cache->stamp;
+			cast++;
+		}
+#ifdef RAYCAST_FIXED_POINT
+		set_hit_slice_fixed(slices, i, hit);
+#else
+		set_hit_slice(slices, i, hit);
+#endif
+		// a reused hit took no steps this frame
+		if (cached) {
+			slices->steps[i] = 0;
+		}
+	}
+	PROFILE_COUNT(COUNTER_RAYS, cast);
+	return cast;
+}
+
+// true if none of the RAY_PACKET_SIZE columns from first_column are cached
+bool packet_uncached(ray_cache* cache, int player_angle, int first_column) {
+	int lane;
+	for (lane = 0; lane < RAY_PACKET_SIZE; lane++) {
+		if (cache->cast_stamp[column_ray_angle(player_angle, first_column + lane)] == cache->stamp) return false;
+	}
+	return true;
+}
+
+// casts the RAY_PACKET_SIZE columns from first_column as a packet, and caches them
+void cast_packet_cached(ray_cache* cache, int player_x, int player_y, int player_angle, int first_column, frame_slices* slices) {
+	ray_hit hits[RAY_PACKET_SIZE];
+	trace_ray_packet(player_x, player_y, column_ray_angle(player_angle, first_column), hits);
+	int lane;
+	for (lane = 0; lane < RAY_PACKET_SIZE; lane++) {
+		int angle = column_ray_angle(player_angle, first_column + lane);
+		cache->hits[angle] = hits[lane];
+		cache->cast_stamp[angle] = cache->stamp;
+		set_hit_slice_fixed(slices, first_column + lane, &hits[lane]);
+	}
+}
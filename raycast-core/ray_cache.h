@@ -0,0 +1,39 @@
+#ifndef RAY_CACHE_H
+#define RAY_CACHE_H
+
+#include <stdbool.h>
+
+#include "raycast.h"
+
+// The hits of the rays cast from one player position, kept across frames so rays that didn't change aren't
+// cast again. Hits are stored by the binary angle of the ray rather than by screen column, and before the
+// fishbowl effect is reversed (see ray_hit), so:
+// - a frame where the player didn't move casts no rays at all,
+// - a frame where the player only turned casts only the columns that came into view, every other column is
+//   the hit of a ray at the same angle cast in an earlier frame, drawn in the column it is in now,
+// - a frame where the player moved, or the map changed (see map_grid.generation), casts every column.
+// The slices drawn from cached hits are exactly the ones the ray caster would have stored.
+
+typedef struct ray_cache {
+	// where the cached rays were cast from, and the generation of the map they were cast against
+	int player_x;
+	int player_y;
+	unsigned int map_generation;
+	// hits[angle] is cached when cast_stamp[angle] == stamp. Moving the stamp on throws every hit away at once
+	unsigned int stamp;
+	unsigned int cast_stamp[ANGLE_UNITS];
+	ray_hit hits[ANGLE_UNITS];
+} ray_cache;
+
+// empties the cache
+void ray_cache_init(ray_cache* cache);
+
+// throws away the cached hits if the player moved or MAP_GRID changed since they were cast. Call once a frame,
+// before any worker calls cast_frame_columns_cached
+void ray_cache_begin_frame(ray_cache* cache, int player_x, int player_y);
+
+// same as cast_frame_columns, but only casts the rays that aren't in the cache, and caches them.
+// Workers can call this at the same time for different ranges of columns. Returns the number of rays cast
+int cast_frame_columns_cached(ray_cache* cache, int player_x, int player_y, int player_angle, int first_column, int last_column, frame_slices* slices);
+
+#endif // RAY_CACHE_H
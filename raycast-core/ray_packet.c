@@ -0,0 +1,232 @@
+#include "ray_packet.h"
+#include "map_grid.h"
+#include "../profile/profile.h"
+
+#if defined(RAY_PACKET_AVX2)
+#include <immintrin.h>
+#endif
+
+#ifdef RAY_PACKETS
+bool RAY_PACKETS_ENABLED = true;
+#else
+bool RAY_PACKETS_ENABLED = false;
+#endif
+bool RAY_PACKET_COUNTS = false;
+long long RAY_PACKETS_TRACED = 0;
+long long RAY_PACKET_SINGLE_RAYS = 0;
+
+// The DDA state of every lane, a field at a time so each one loads into a vector.
+// active is -1 for the lanes still tracing and 0 for the rest. After step_packet, distance is the distance at
+// which each lane crossed into its new cell, and crossed_x is -1 where that was a vertical grid line
+typedef struct ray_packet {
+	int side_x[RAY_PACKET_SIZE];
+	int side_y[RAY_PACKET_SIZE];
+	int delta_x[RAY_PACKET_SIZE];
+	int delta_y[RAY_PACKET_SIZE];
+	int cell_x[RAY_PACKET_SIZE];
+	int cell_y[RAY_PACKET_SIZE];
+	int active[RAY_PACKET_SIZE];
+	int distance[RAY_PACKET_SIZE];
+	int crossed_x[RAY_PACKET_SIZE];
+} ray_packet;
+
+void step_packet(ray_packet* packet, int step_x, int step_y);
+unsigned int lanes_in_cell(ray_packet* packet, int cell_x, int cell_y);
+void skip_lane(ray_packet* packet, fixed_ray* ray, int lane, int shift);
+void store_lane(ray_packet* packet, fixed_ray* ray, int lane);
+
+void reset_packet_counts(void) {
+	RAY_PACKETS_TRACED = 0;
+	RAY_PACKET_SINGLE_RAYS = 0;
+}
+
+void cast_packet_columns(int player_x, int player_y, int player_angle, int first_column, int last_column, frame_slices* slices) {
+	ray_hit hits[RAY_PACKET_SIZE];
+	int i, lane;
+	for (i = first_column; i + RAY_PACKET_SIZE <= last_column; i += RAY_PACKET_SIZE) {
+		trace_ray_packet(player_x, player_y, column_ray_angle(player_angle, i), hits);
+		for (lane = 0; lane < RAY_PACKET_SIZE; lane++) set_hit_slice_fixed(slices, i + lane, &hits[lane]);
+	}
+	for (; i < last_column; i++) {
+		cast_ray_fixed(player_x, player_y, player_angle, i, slices);
+	}
+}
+
+void trace_ray_packet(int player_x, int player_y, int first_angle, ray_hit hits[RAY_PACKET_SIZE]) {
+	fixed_ray rays[RAY_PACKET_SIZE];
+	int i;
+	for (i = 0; i < RAY_PACKET_SIZE; i++) {
+		start_ray_fixed(&rays[i], player_x, player_y, wrap_angle(first_angle - i));
+	}
+
+	// the lanes can only step together if they all step the same way
+	bool diverged = false;
+	for (i = 0; i < RAY_PACKET_SIZE; i++) {
+		if (rays[i].step_x != rays[0].step_x || rays[i].step_y != rays[0].step_y ||
+			rays[i].delta_x == INT_MAX || rays[i].delta_y == INT_MAX) {
+			diverged = true;
+		}
+	}
+	if (RAY_PACKET_COUNTS) {
+		__atomic_fetch_add(&RAY_PACKETS_TRACED, 1, __ATOMIC_RELAXED);
+		if (diverged) __atomic_fetch_add(&RAY_PACKET_SINGLE_RAYS, RAY_PACKET_SIZE, __ATOMIC_RELAXED);
+	}
+	if (diverged) {
+		for (i = 0; i < RAY_PACKET_SIZE; i++) finish_ray_fixed(&rays[i], &hits[i]);
+		return;
+	}
+
+	ray_packet packet;
+	for (i = 0; i < RAY_PACKET_SIZE; i++) {
+		packet.side_x[i] = rays[i].side_x;
+		packet.side_y[i] = rays[i].side_y;
+		packet.delta_x[i] = rays[i].delta_x;
+		packet.delta_y[i] = rays[i].delta_y;
+		packet.cell_x[i] = rays[i].cell.x;
+		packet.cell_y[i] = rays[i].cell.y;
+		packet.active[i] = -1;
+	}
+	int step_x = rays[0].step_x, step_y = rays[0].step_y;
+
+	// a bit per lane still tracing. They all start in the player's cell
+	unsigned int lanes = (1u << RAY_PACKET_SIZE) - 1;
+	int steps = 0;
+	// the first lane still tracing, whose cell the pyramid is looked up in. Only inside the map, see cast_ray
+	int lead = 0;
+	int shift = outside_map_bounds(packet.cell_x[lead], packet.cell_y[lead]) ? 0 : map_empty_block_shift(packet.cell_x[lead], packet.cell_y[lead]);
+	while (true) {
+		// in an empty block of the map pyramid, jump every lane to the last cell before it leaves the block
+		if (shift > 0) {
+			for (i = lead; i < RAY_PACKET_SIZE; i++) {
+				if (lanes & (1u << i)) skip_lane(&packet, &rays[i], i, shift);
+			}
+		}
+
+		step_packet(&packet, step_x, step_y);
+		steps++;
+
+		// mask out the lanes that hit a wall or left the map, looking the cell up once if they are all in it
+		unsigned int finished = 0;
+		bool together = (lanes_in_cell(&packet, packet.cell_x[lead], packet.cell_y[lead]) & lanes) == lanes;
+		if (together) {
+			if (outside_map_bounds(packet.cell_x[lead], packet.cell_y[lead]) || map_cell_solid(packet.cell_x[lead], packet.cell_y[lead])) {
+				finished = lanes;
+			}
+		} else {
+			for (i = lead; i < RAY_PACKET_SIZE; i++) {
+				if ((lanes & (1u << i)) && (outside_map_bounds(packet.cell_x[i], packet.cell_y[i]) || map_cell_solid(packet.cell_x[i], packet.cell_y[i]))) {
+					finished |= 1u << i;
+				}
+			}
+		}
+		for (i = lead; finished != 0 && i < RAY_PACKET_SIZE; i++) {
+			if (!(finished & (1u << i))) continue;
+			rays[i].context.steps = steps;
+			if (outside_map_bounds(packet.cell_x[i], packet.cell_y[i])) {
+				set_missed_hit(&hits[i], steps);
+				PROFILE_ONLY(count_ray_steps(&rays[i].context));
+			} else {
+				rays[i].cell.x = packet.cell_x[i];
+				rays[i].cell.y = packet.cell_y[i];
+				wall_face face = packet.crossed_x[i] ? ((step_x > 0) ? FACE_WEST : FACE_EAST) : ((step_y > 0) ? FACE_NORTH : FACE_SOUTH);
+				set_fixed_ray_hit(&rays[i], packet.distance[i], face, &hits[i]);
+			}
+			packet.active[i] = 0;
+		}
+		lanes &= ~finished;
+
+		// the lanes left crossed into different cells, or too few are left to be worth stepping together
+		if (__builtin_popcount(lanes) <= RAY_PACKET_MIN_LANES) {
+			break;
+		}
+		lead = __builtin_ctz(lanes);
+		if (!together && (lanes_in_cell(&packet, packet.cell_x[lead], packet.cell_y[lead]) & lanes) != lanes) {
+			break;
+		}
+		// the lanes that left the map are finished, so the rest are inside it
+		shift = map_empty_block_shift(packet.cell_x[lead], packet.cell_y[lead]);
+	}
+
+	// finish the lanes left one at a time
+	if (RAY_PACKET_COUNTS) {
+		__atomic_fetch_add(&RAY_PACKET_SINGLE_RAYS, __builtin_popcount(lanes), __ATOMIC_RELAXED);
+	}
+	for (i = 0; i < RAY_PACKET_SIZE; i++) {
+		if (lanes & (1u << i)) {
+			rays[i].context.steps = steps;
+			store_lane(&packet, &rays[i], i);
+			finish_ray_fixed(&rays[i], &hits[i]);
+		}
+	}
+}
+
+void skip_lane(ray_packet* packet, fixed_ray* ray, int lane, int shift) {
+	grid_point cell = { packet->cell_x[lane], packet->cell_y[lane] };
+	PROFILE_ONLY(ray->context.block_skips++);
+	skip_empty_block_fixed(shift, &cell, ray->step_x, ray->step_y, packet->delta_x[lane], packet->delta_y[lane],
+		&packet->side_x[lane], &packet->side_y[lane]);
+	packet->cell_x[lane] = cell.x;
+	packet->cell_y[lane] = cell.y;
+}
+
+// copies a lane's DDA state back into its ray, to finish it on its own
+void store_lane(ray_packet* packet, fixed_ray* ray, int lane) {
+	ray->cell.x = packet->cell_x[lane];
+	ray->cell.y = packet->cell_y[lane];
+	ray->side_x = packet->side_x[lane];
+	ray->side_y = packet->side_y[lane];
+}
+
+// ---- the DDA step of every lane, and which lanes are in a cell ----
+// Each active lane crosses whichever of its next grid lines is closer, the horizontal one on a tie, as in
+// finish_ray_fixed. The sides only grow, and side_x < side_y picks the lane's crossing without a branch.
+// lanes_in_cell returns a bit per lane, set for the lanes in cell (cell_x, cell_y)
+
+#if defined(RAY_PACKET_AVX2)
+
+void step_packet(ray_packet* packet, int step_x, int step_y) {
+	__m256i side_x = _mm256_loadu_si256((const __m256i*)packet->side_x), side_y = _mm256_loadu_si256((const __m256i*)packet->side_y);
+	__m256i active = _mm256_loadu_si256((const __m256i*)packet->active);
+	__m256i crossed_x = _mm256_cmpgt_epi32(side_y, side_x);
+	__m256i move_x = _mm256_and_si256(crossed_x, active), move_y = _mm256_andnot_si256(crossed_x, active);
+
+	_mm256_storeu_si256((__m256i*)packet->distance, _mm256_blendv_epi8(side_y, side_x, crossed_x));
+	_mm256_storeu_si256((__m256i*)packet->crossed_x, crossed_x);
+	_mm256_storeu_si256((__m256i*)packet->side_x, _mm256_add_epi32(side_x, _mm256_and_si256(_mm256_loadu_si256((const __m256i*)packet->delta_x), move_x)));
+	_mm256_storeu_si256((__m256i*)packet->side_y, _mm256_add_epi32(side_y, _mm256_and_si256(_mm256_loadu_si256((const __m256i*)packet->delta_y), move_y)));
+	_mm256_storeu_si256((__m256i*)packet->cell_x, _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)packet->cell_x), _mm256_and_si256(_mm256_set1_epi32(step_x), move_x)));
+	_mm256_storeu_si256((__m256i*)packet->cell_y, _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)packet->cell_y), _mm256_and_si256(_mm256_set1_epi32(step_y), move_y)));
+}
+
+unsigned int lanes_in_cell(ray_packet* packet, int cell_x, int cell_y) {
+	__m256i same_x = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)packet->cell_x), _mm256_set1_epi32(cell_x));
+	__m256i same_y = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)packet->cell_y), _mm256_set1_epi32(cell_y));
+	return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(same_x, same_y)));
+}
+
+#else
+
+void step_packet(ray_packet* packet, int step_x, int step_y) {
+	int i;
+	for (i = 0; i < RAY_PACKET_SIZE; i++) {
+		int crossed_x = (packet->side_x[i] < packet->side_y[i]) ? -1 : 0;
+		int move_x = crossed_x & packet->active[i], move_y = ~crossed_x & packet->active[i];
+		packet->distance[i] = crossed_x ? packet->side_x[i] : packet->side_y[i];
+		packet->crossed_x[i] = crossed_x;
+		packet->side_x[i] += packet->delta_x[i] & move_x;
+		packet->side_y[i] += packet->delta_y[i] & move_y;
+		packet->cell_x[i] += step_x & move_x;
+		packet->cell_y[i] += step_y & move_y;
+	}
+}
+
+unsigned int lanes_in_cell(ray_packet* packet, int cell_x, int cell_y) {
+	unsigned int in_cell = 0;
+	int i;
+	for (i = 0; i < RAY_PACKET_SIZE; i++) {
+		if (packet->cell_x[i] == cell_x && packet->cell_y[i] == cell_y) in_cell |= 1u << i;
+	}
+	return in_cell;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef RAY_PACKET_H
+#define RAY_PACKET_H
+
+#include <stdbool.h>
+
+#include "raycast.h"
+
+// Packet traversal for the fixed point ray caster. The rays of neighbouring columns are only RAY_ANGLE_INC
+// apart, so they step the same way through the grid and mostly cross the same cells. trace_ray_packet starts
+// RAY_PACKET_SIZE of them and steps them together:
+// - the DDA's compare and step run on every lane at once, 8 lanes with AVX2,
+// - while every lane is in the same cell, the map pyramid and the cell are looked up once for the whole packet,
+//   otherwise once per lane,
+// - a lane is masked out when its ray hits a wall or leaves the map.
+// When the rays diverge the packet falls back to tracing them one at a time with finish_ray_fixed: from the start
+// if they step in different directions (a packet across a multiple of 90 degrees, or a ray parallel to the grid),
+// and from where they are once only RAY_PACKET_MIN_LANES lanes are left.
+// The hits, steps included, are exactly those of trace_ray_fixed. bench --packets checks it and times both.
+// Without AVX2, packets of 4 step their lanes in a plain loop: 4 lanes of SSE2 ran no faster than single rays, so
+// there is no SSE2 or NEON version. Lanes that jump through different blocks of the map pyramid split into
+// different cells, so open maps finish most rays one at a time. Stepping them on in the packet instead ran at half
+// the speed of single rays there, as the lanes that finish early wait for the longest ray.
+
+#if defined(__AVX2__) && !defined(RAY_PACKET_SCALAR)
+#define RAY_PACKET_AVX2
+#define RAY_PACKET_SIZE 8
+#define RAY_PACKET_KERNELS "avx2"
+#else
+#define RAY_PACKET_SIZE 4
+#define RAY_PACKET_KERNELS "scalar"
+#endif
+
+// the packet finishes its last lanes one at a time once this few are left
+#define RAY_PACKET_MIN_LANES (RAY_PACKET_SIZE / 4)
+
+// when true, the fixed point ray caster casts neighbouring columns in packets (see cast_frame_columns). true when
+// built with RAY_PACKETS (make PACKETS=1, and make SIMD=avx2 unless PACKETS=0), false otherwise
+extern bool RAY_PACKETS_ENABLED;
+
+// packets traced since the last reset_packet_counts, and how many of their rays were finished one at a time.
+// Only counted while RAY_PACKET_COUNTS is true, for benchmarks
+extern bool RAY_PACKET_COUNTS;
+extern long long RAY_PACKETS_TRACED;
+extern long long RAY_PACKET_SINGLE_RAYS;
+void reset_packet_counts(void);
+
+// casts the rays of screen columns first_column to last_column - 1 into slices like cast_frame_columns, a
+// packet of RAY_PACKET_SIZE columns at a time and the columns left over one at a time
+void cast_packet_columns(int player_x, int player_y, int player_angle, int first_column, int last_column, frame_slices* slices);
+
+// traces the rays at first_angle, first_angle - 1, ... first_angle - (RAY_PACKET_SIZE - 1), the rays of
+// RAY_PACKET_SIZE neighbouring columns from left to right, into hits
+void trace_ray_packet(int player_x, int player_y, int first_angle, ray_hit hits[RAY_PACKET_SIZE]);
+
+#endif // RAY_PACKET_H
@@ -1,245 +1,226 @@
-
 #include "raycast.h"
-#include "../Map_Data.h"
-
-#define PROJECTION_FACTOR 5500
-#define HALF_FOV FOV / 2.0
-
-// emits a ray from first intersection with the grid, and traces it until it hits either a wall or goes out of bounds
-// if the ray goes out of bounds, return point(INT_MAX, INT_MAX)
-// else return the unit coordinates of the location where wall was found
-point emit_and_trace_ray(int first_inter_x, int first_inter_y, int inter_offset_x, int inter_offset_y);
-
-double inline reverse_fishbowl(double polar_distance);
-point inline make_point(int x, int y);
-slice_info* make_slice_info(int size, int location);
-grid_point convert_to_grid_point(int unit_x, int unit_y);
-bool outside_map_bounds(int unit_x, int unit_y);
-
-/* ALPHA is the current angle at which a ray is being cast.To get it, we
-shift to the left of the FOV from the player angle (angle + FOV / 2) and then
-subtract in increments of RAY_ANGLE_INC degrees till we span the entire FOV. 
-ALPHA varies from 0 - 360. */
-double ALPHA;
-
-/* BETA is the angle of the ray relative to player angle, used to reverse
-the fishbowl effect */
-double BETA;
-
-slice_info* cast_ray(int playerX, int playerY, double player_angle, int screen_column) {
-
-	// screen_column_angle is the angle from the left of the FOV to the casted ray (at this screen column)
-	double screen_column_angle = screen_column * RAY_ANGLE_INC;
-	
-	// move to the left of the FOV then subtract the offset to compute angle at this screen column
-	ALPHA = player_angle - screen_column_angle + HALF_FOV;
-
-	// BETA is angle between the casted ray and the player angle (center of FOV)
-	BETA = screen_column_angle - HALF_FOV;
-
-	// wrap around ALPHA to keep it within the bounds of 0 - 360
-	if (ALPHA < 0.0) ALPHA += 360.0;
-	else if (ALPHA > 360.0) ALPHA -= 360.0;
-	
-	point horizontal_intersection = find_closest_horizontal_wall_intersection(playerX, playerY);
-	point vertical_intersection = find_closest_vertical_wall_intersection(playerX, playerY);
-
-	double closest_distance = find_closest_distance_to_wall(playerX, playerY, &horizontal_intersection, &vertical_intersection);
-	
-	if (closest_distance == 0) {
-		// no wall intersections were found at this ray
-		return make_slice_info(INT_MAX, INT_MAX);
-	} else {
-		// reverse fishbowl the distance and apply the projection factor to find the slice size
-		int slice_size = PROJECTION_FACTOR / (reverse_fishbowl(closest_distance));
-		// limit slice size to the maximum value for this resolution, if it is bigger than the screen
-		if (slice_size > SCREEN_SIZE_Y) slice_size = SCREEN_SIZE_Y;
-		// return a slice info. location of slice is from the top of the screen
-		return make_slice_info(slice_size, (SCREEN_SIZE_Y - slice_size) / 2);
-	}
+#include "map_grid.h"
+#include "ray_packet.h"
+#include "../profile/profile.h"
+
+static inline void skip_empty_block(int shift, grid_point* cell, int step_x, int step_y, double delta_x, double delta_y, double* side_x, double* side_y);
+
+void init_ray_context(ray_context* ray, int player_x, int player_y, int ray_angle) {
+	ray->player_x = player_x;
+	ray->player_y = player_y;
+	ray->angle = ray_angle;
+	ray->steps = 0;
+	ray->block_skips = 0;
 }
 
-point find_closest_horizontal_wall_intersection(int playerX, int playerY) {
-
-	// first_inter x and y are the (x, y) unit coords of the first intersection with the grid
-	// inter_offset x and y are (x, y) offsets to get from the current intersection to the next intersection with the grid
-	// current_inter x and y are the (x, y) unit coords of the current intersection of the ray with the grid (i.e. at
-	// this moment in the ray travel)
-	int first_inter_x, first_inter_y, inter_offset_x, inter_offset_y;
-	
-	// --------------------------------- compute first intersection with the grid and offset -----------------------
-
-	if (ALPHA >= 0 && ALPHA < 180) {
-		// ray facing up
-		first_inter_y = ((playerY >> 6) << 6) - 1; // subtract 1 to make A part of the grid block above the grid line
-		// move the ray upwards by 64 unit coords when the ray is facing upwards
-		inter_offset_y = -64;
-	} else if (ALPHA >= 180 && ALPHA < 360) {
-		// ray facing down
-		first_inter_y = ((playerY >> 6) << 6) + 64; // add 64 to make first_inter_y the y position of the next grid block
-		// move the ray downwards by 64 unit coords when the ray is facing downwards
-		inter_offset_y = 64;
-	}
+#ifdef PROFILE
+void count_ray_steps(ray_context* ray) {
+	PROFILE_COUNT(COUNTER_STEPS, ray->steps);
+	PROFILE_COUNT(COUNTER_BLOCK_SKIPS, ray->block_skips);
+}
+#endif
 
-	// pre-compute tan(alpha) for speed
-	double tan_alpha = tand(ALPHA);
+void cast_frame(int playerX, int playerY, int player_angle, frame_slices* slices) {
+	cast_frame_columns(playerX, playerY, player_angle, 0, SCREEN_SIZE_X, slices);
+}
 
-	if (tan_alpha == 0) {
-		// abort, there is no horizontal intersection!
-		return make_point(INT_MAX, INT_MAX);
-	} else if (abs(ALPHA - 90) < 0.7 || abs(ALPHA - 270) < 0.7) {
-		first_inter_x = playerX;
-		inter_offset_x = 0;
-	} else {
-		// calculate first_inter_x using line formula
-		first_inter_x = playerX + (playerY - first_inter_y) / tan_alpha;
-		// calculate projection of inter_offset_y on x axis. -ve because Y axis is flipped
-		inter_offset_x = -inter_offset_y / tan_alpha;
+void cast_frame_columns(int playerX, int playerY, int player_angle, int first_column, int last_column, frame_slices* slices) {
+	PROFILE_COUNT(COUNTER_RAYS, last_column - first_column);
+#ifdef RAYCAST_FIXED_POINT
+	if (RAY_PACKETS_ENABLED) {
+		cast_packet_columns(playerX, playerY, player_angle, first_column, last_column, slices);
+		return;
+	}
+#endif
+	int i;
+	for (i = first_column; i < last_column; i++) {
+#ifdef RAYCAST_FIXED_POINT
+		cast_ray_fixed(playerX, playerY, player_angle, i, slices);
+#else
+		cast_ray(playerX, playerY, player_angle, i, slices);
+#endif
 	}
-
-	// ---------------------------- emit and trace the ray from first intersection outwards -----------------------
-
-	//  offsets are used to move the head of the ray forward, until ray hits a wall or goes out of bounds
-	return emit_and_trace_ray(first_inter_x, first_inter_y, inter_offset_x, inter_offset_y);
 }
 
-point find_closest_vertical_wall_intersection(int playerX, int playerY) {
-
-	int first_inter_x, first_inter_y, inter_offset_x, inter_offset_y;
+void cast_ray(int playerX, int playerY, int player_angle, int screen_column, frame_slices* slices) {
+	ray_hit hit;
+	trace_ray(playerX, playerY, column_ray_angle(player_angle, screen_column), &hit);
+	set_hit_slice(slices, screen_column, &hit);
+}
 
-	if (ALPHA >= 90 && ALPHA < 270) {
-		first_inter_x = ((playerX >> 6) << 6) - 1;
-		inter_offset_x = -64;
-	} else if ((ALPHA >= 270 && ALPHA < 360) || (ALPHA >= 0 && ALPHA < 90)) {
-		first_inter_x = ((playerX >> 6) << 6) + 64;
-		inter_offset_x = 64;
-	}
-	
-	double tan_alpha = tand(ALPHA);
+void trace_ray(int playerX, int playerY, int ray_angle, ray_hit* hit) {
 
-	first_inter_y = playerY + (playerX - first_inter_x) * tan_alpha;		
-	inter_offset_y = -inter_offset_x * tan_alpha;
-	
-	// ---------------------------- emit and trace the ray from first intersection outwards -----------------------
+	ray_context ray;
+	init_ray_context(&ray, playerX, playerY, ray_angle);
+	ray.alpha = angle_to_degrees(ray.angle);
 
-	//  offsets are used to move the head of the ray forward, until ray hits a wall or goes out of bounds
-	return emit_and_trace_ray(first_inter_x, first_inter_y, inter_offset_x, inter_offset_y);
-}
+	// ------------------------------- set up the ray for grid traversal (DDA) ----------------------------------
 
-point emit_and_trace_ray(int first_inter_x, int first_inter_y, int inter_offset_x, int inter_offset_y) {
+	// direction of the ray. The y axis is flipped, so a ray facing up (alpha < 180) travels towards -y
+	double dir_x = cosd(ray.alpha);
+	double dir_y = -sind(ray.alpha);
 
-	// the ray starts at the first intersection
-	int current_inter_x = first_inter_x;
-	int current_inter_y = first_inter_y;
+	// the grid cell the ray is in, and the direction it moves to the next cell in x and y
+	grid_point cell;
+	cell.x = playerX >> 6;
+	cell.y = playerY >> 6;
+	int step_x = (dir_x < 0) ? -1 : 1;
+	int step_y = (dir_y < 0) ? -1 : 1;
 
-	// ------------------------------------- emit the ray ------------------------------------------
+	// delta x and y are the distances the ray travels between two vertical grid lines, and between two horizontal
+	// grid lines. side x and y are the distances the ray has travelled when it reaches the next vertical and
+	// horizontal grid line. A ray parallel to one set of grid lines never reaches them
+	double delta_x = INFINITY, delta_y = INFINITY, side_x = INFINITY, side_y = INFINITY;
+	if (dir_x != 0) {
+		delta_x = fabs(64 / dir_x);
+		side_x = ((dir_x < 0) ? playerX - cell.x * 64 : (cell.x + 1) * 64 - playerX) * delta_x / 64;
+	}
+	if (dir_y != 0) {
+		delta_y = fabs(64 / dir_y);
+		side_y = ((dir_y < 0) ? playerY - cell.y * 64 : (cell.y + 1) * 64 - playerY) * delta_y / 64;
+	}
 
-	// constantly calculate new intersections with the grid, and check if a wall exists there
-	bool reached_map_bounds = false;
+	// ------------------------------------- trace the ray ------------------------------------------
 
-	// if either a wall exists or map bounds are reached, break out!
+	// move the ray across whichever grid line is closer, one cell at a time, until it reaches a wall or leaves the map
+	double distance;
+	wall_face face;
+	// the pyramid is only looked up in cells inside the map. A player who walked off the map starts outside it
+	int shift = outside_map_bounds(cell.x, cell.y) ? 0 : map_empty_block_shift(cell.x, cell.y);
 	while (true) {
+		// in an empty block of the map pyramid, jump to the last cell before the ray leaves the block
+		if (shift > 0) {
+			PROFILE_ONLY(ray.block_skips++);
+			skip_empty_block(shift, &cell, step_x, step_y, delta_x, delta_y, &side_x, &side_y);
+		}
 
-		// find the grid location where these unit coordinates lie
-		grid_point current_inter_grid_point = convert_to_grid_point(current_inter_x, current_inter_y);
-
-		// -------------------- check whether or not to break out of ray casting --------------
-
-		// check if a wall exists at this grid location
-		if (MAP_DATA[current_inter_grid_point.x][current_inter_grid_point.y] == 1) {
-			// we've reached a wall, these are our wall unit coordinates
-			// break to prevent moving ray further
-			break;
+		if (side_x < side_y) {
+			distance = side_x;
+			side_x += delta_x;
+			cell.x += step_x;
+			face = (step_x > 0) ? FACE_WEST : FACE_EAST;
+		} else {
+			distance = side_y;
+			side_y += delta_y;
+			cell.y += step_y;
+			face = (step_y > 0) ? FACE_NORTH : FACE_SOUTH;
 		}
-		else if (outside_map_bounds(current_inter_x, current_inter_y)) {
+		ray.steps++;
+
+		if (outside_map_bounds(cell.x, cell.y)) {
 			// we've reached map bounds without finding a wall
-			// break to exit to prevent ray moving further out of bounds
-			reached_map_bounds = true;
+			set_missed_hit(hit, ray.steps);
+			PROFILE_ONLY(count_ray_steps(&ray));
+			return;
+		} else if (map_cell_solid(cell.x, cell.y)) {
+			// we've reached a wall
 			break;
 		}
-
-		// -------------------- move ray further --------------
-
-		// increment current_inter x and y with the offsets to trace the ray further since
-		// we haven't reached a wall or map bounds
-		current_inter_x += inter_offset_x;
-		current_inter_y += inter_offset_y;
+		shift = map_empty_block_shift(cell.x, cell.y);
 	}
 
-	// if map bounds reached, error! else return current location of the ray
-	if (reached_map_bounds) {
-		return make_point(INT_MAX, INT_MAX);
-	}
-	else {
-		return make_point(current_inter_x, current_inter_y);
+	// the unit coordinate along the face where the ray hit it. faces of vertical grid lines run along y
+	int hit_position = (face == FACE_WEST || face == FACE_EAST) ? floor(playerY + distance * dir_y) : floor(playerX + distance * dir_x);
+
+	// convert unit coordinates to 16.16 grid cells, rounded to the nearest
+	hit->distance = (int)lround(distance * (FIXED_ONE / 64));
+	hit->cell_x = cell.x;
+	hit->cell_y = cell.y;
+	hit->face = face;
+	hit->texture_u = wall_face_offset(face, hit_position);
+	hit->steps = ray.steps;
+	PROFILE_ONLY(count_ray_steps(&ray));
+}
+
+void set_hit_slice(frame_slices* slices, int screen_column, const ray_hit* hit) {
+	if (hit->cell_x < 0) {
+		set_empty_slice(slices, screen_column);
+	} else {
+		// reverse fishbowl the distance with the angle between this column's ray and the player angle
+		int perpendicular_distance = (int)(hit->distance * cosd(angle_to_degrees(screen_column - HALF_FOV_UNITS)));
+		grid_point cell = { hit->cell_x, hit->cell_y };
+		set_slice(slices, screen_column, perpendicular_distance, cell, hit->face, hit->texture_u);
 	}
+	slices->steps[screen_column] = hit->steps;
 }
 
-// if no wall exists at this ray, returns 0
-double find_closest_distance_to_wall(int playerX, int playerY, point* horiz_intersection, point* vert_intersection) {
+// moves the ray through the empty (1 << shift) cell block it is in to the cell it leaves the block from,
+// see the fixed point version in raycast_fixed.c. Multiplying the deltas instead of adding them one cell at a
+// time can round differently, so a ray passing within rounding error of a grid corner may cross it the other way
+static inline void skip_empty_block(int shift, grid_point* cell, int step_x, int step_y, double delta_x, double delta_y, double* side_x, double* side_y) {
 
-	double cos_alpha = cosd(ALPHA);
+	int block_x = cell->x & -(1 << shift), block_y = cell->y & -(1 << shift);
+	int crossings_x = (step_x > 0) ? block_x + (1 << shift) - cell->x : cell->x - block_x + 1;
+	int crossings_y = (step_y > 0) ? block_y + (1 << shift) - cell->y : cell->y - block_y + 1;
 
-	double distance_horiz, distance_vert;
+	// a delta of INFINITY times zero crossings would be NaN
+	double exit_x = (crossings_x > 1) ? *side_x + (crossings_x - 1) * delta_x : *side_x;
+	double exit_y = (crossings_y > 1) ? *side_y + (crossings_y - 1) * delta_y : *side_y;
 
-	// roughly a degree on either side of 90
-	if (abs(cos_alpha) < 0.0174524) {
-		return distance_horiz = playerY - vert_intersection->y;
-			//distance_vert = 0;
-			//else if (abs(ALPHA - 270.0) < 0.00001) {
-			//distance_horiz = horiz_intersection->y - playerY;
-			//distance_vert = 0;
-		//}
+	int steps_x, steps_y;
+	if (exit_x < exit_y) {
+		steps_x = crossings_x - 1;
+		steps_y = (*side_y <= exit_x) ? floor((exit_x - *side_y) / delta_y) + 1 : 0;
+		if (steps_y > crossings_y - 1) steps_y = crossings_y - 1;
 	} else {
-		// calculate distances to the horizontal and vertical intersections
-		distance_horiz = (playerX - horiz_intersection->x) / cos_alpha;
-		distance_vert = (playerX - vert_intersection->x) / cos_alpha;
+		steps_y = crossings_y - 1;
+		steps_x = (*side_x < exit_y) ? ceil((exit_y - *side_x) / delta_x) : 0;
+		if (steps_x > crossings_x - 1) steps_x = crossings_x - 1;
 	}
 
-	// if the point is (INT_MAX, INT_MAX), no intersection was found
-
-	if (horiz_intersection->x == INT_MAX && vert_intersection->x != INT_MAX) {
-		// no horizontal intersection found but vert found, so closest distance is distance_vert
-		return distance_vert;
-	} else if (vert_intersection->x == INT_MAX && horiz_intersection->x != INT_MAX) {
-		// no vertical intersection found but horiz found, so closest distance is distance_horiz
-		return distance_horiz;
-	} else if (vert_intersection->x != INT_MAX && horiz_intersection->x != INT_MAX) {
-		// both intersections were found
-		return (distance_horiz > distance_vert) ? distance_horiz : distance_vert;
-	} else {
-		// no intersections were found
-		return 0;
-	}
+	cell->x += step_x * steps_x;
+	cell->y += step_y * steps_y;
+	if (steps_x > 0) *side_x += steps_x * delta_x;
+	if (steps_y > 0) *side_y += steps_y * delta_y;
+}
+
+bool outside_map_bounds(int grid_x, int grid_y) {
+	return (grid_x >= MAP_GRID.size_x || grid_x < 0 || grid_y >= MAP_GRID.size_y || grid_y < 0);
 }
 
-double inline reverse_fishbowl(double polar_distance) {
-	return polar_distance * cosd(BETA);
+int wall_face_offset(wall_face face, int hit_position) {
+	int offset = hit_position & 63;
+	// the player sees east and north faces looking towards -x and +y, so they run the other way across the screen
+	return (face == FACE_EAST || face == FACE_NORTH) ? 63 - offset : offset;
 }
 
-point inline make_point(int x, int y) {
-	point pt;
-	pt.x = x;
-	pt.y = y;
-	return pt;
+int projected_slice_size(int distance) {
+	// apply the projection factor to the distance in unit coordinates
+	return (PROJECTION_FACTOR << (FIXED_SHIFT - 6)) / ((distance > 0) ? distance : 1);
 }
 
-slice_info* make_slice_info(int size, int location) {
-	slice_info* slice_info_ptr = malloc(sizeof(slice_info));
-	slice_info_ptr->size = size;
-	slice_info_ptr->location = location;
-	return slice_info_ptr;
+void set_slice(frame_slices* slices, int screen_column, int distance, grid_point cell, wall_face face, int offset) {
+
+	// limit the slice size to the maximum value for this resolution
+	int slice_size = projected_slice_size(distance);
+	if (slice_size > SCREEN_SIZE_Y) slice_size = SCREEN_SIZE_Y;
+
+	slices->size[screen_column] = slice_size;
+	slices->location[screen_column] = (SCREEN_SIZE_Y - slice_size) / 2;
+	slices->distance[screen_column] = distance;
+	slices->cell_x[screen_column] = cell.x;
+	slices->cell_y[screen_column] = cell.y;
+	slices->face[screen_column] = face;
+	slices->texture_u[screen_column] = offset;
+	slices->tile_type[screen_column] = map_tile_type(&MAP_GRID, cell.x, cell.y);
 }
 
-grid_point convert_to_grid_point(int unit_x, int unit_y) {
-	grid_point pt;
-	pt.x = unit_x >> 6;
-	pt.y = unit_y >> 6;
-	return pt;
+void set_missed_hit(ray_hit* hit, int steps) {
+	hit->distance = 0;
+	hit->cell_x = -1;
+	hit->cell_y = -1;
+	hit->face = FACE_NORTH;
+	hit->texture_u = 0;
+	hit->steps = steps;
 }
 
-bool outside_map_bounds(int unit_x, int unit_y) {
-	// each grid location is 64 unit coordinates in size
-	// check if unit coords are outside (0, MAP_SIZE_X * 64) and (0, MAP_SIZE_Y * 64)
-	return (unit_x > MAP_SIZE_X << 6 || unit_x < 0 || unit_y > MAP_SIZE_Y << 6 || unit_y < 0);
-}
\ No newline at end of file
+void set_empty_slice(frame_slices* slices, int screen_column) {
+	slices->size[screen_column] = INT_MAX;
+	slices->location[screen_column] = INT_MAX;
+	slices->distance[screen_column] = 0;
+	slices->cell_x[screen_column] = -1;
+	slices->cell_y[screen_column] = -1;
+	slices->face[screen_column] = FACE_NORTH;
+	slices->texture_u[screen_column] = 0;
+	slices->tile_type[screen_column] = 0;
+}
@@ -10,6 +10,8 @@
 #define SCREEN_SIZE_Y 240
 #define FOV 60.0
 #define RAY_ANGLE_INC (FOV/SCREEN_SIZE_X)
+// slice size = PROJECTION_FACTOR / distance to the wall
+#define PROJECTION_FACTOR 5500
 
 #ifndef M_PI
 #    define M_PI 3.14159265358979323846
@@ -19,6 +21,19 @@
 #define cosd(x) (cos((x) * M_PI / 180))
 #define tand(x) (tan((x) * M_PI / 180))
 
+// Angles are binary angles: integers in units of RAY_ANGLE_INC, so turning by one screen column is exactly 1
+// and repeated turns never drift. ANGLE_UNITS of them make up 360 degrees
+#define ANGLE_UNITS 1920
+#define HALF_FOV_UNITS (SCREEN_SIZE_X / 2)
+
+#define angle_to_degrees(a) ((a) * RAY_ANGLE_INC)
+// wraps a binary angle around to 0 - ANGLE_UNITS
+#define wrap_angle(a) ((((a) % ANGLE_UNITS) + ANGLE_UNITS) % ANGLE_UNITS)
+
+// distances are in grid cells (64 unit coordinates), 16.16 fixed point
+#define FIXED_SHIFT 16
+#define FIXED_ONE (1 << FIXED_SHIFT)
+
 // if point is out of map bounds, x = y = INT_MAX
 typedef struct point_unit_coords {
 	int x;
@@ -31,20 +46,149 @@ typedef struct point_grid_coords {
 	int y;
 } grid_point;
 
-// if slice does not exist at this location, size = location = INT_MAX
-typedef struct slice_info {
-	int size;
-	int location;
-	// additional texture info can be inserted here later
-} slice_info;
+// the side of the wall block a ray hit. A ray travelling right (+x) hits the west face
+typedef enum wall_face {
+	FACE_NORTH,
+	FACE_EAST,
+	FACE_SOUTH,
+	FACE_WEST
+} wall_face;
+
+// The wall slices of every screen column, filled in by cast_frame. The caller owns the buffer, and each
+// field is its own array so drawing can stream through the ones it needs.
+// If a slice does not exist at a column, size = location = INT_MAX and distance = 0
+typedef struct frame_slices {
+	int size[SCREEN_SIZE_X];
+	// location of slice is from the top of the screen
+	int location[SCREEN_SIZE_X];
+	// perpendicular distance from the player to the wall (with the fishbowl effect reversed)
+	int distance[SCREEN_SIZE_X];
+	// the wall block that was hit and the face of it that was hit
+	short int cell_x[SCREEN_SIZE_X];
+	short int cell_y[SCREEN_SIZE_X];
+	unsigned char face[SCREEN_SIZE_X];
+	// where the ray hit the face, 0 - 63 unit coordinates from the left edge as seen by the player.
+	// This is the texture column to draw
+	unsigned char texture_u[SCREEN_SIZE_X];
+	// tile type of the wall block that was hit, from MAP_GRID
+	unsigned char tile_type[SCREEN_SIZE_X];
+	// the number of steps the ray took through the grid (see ray_context.steps), for benchmarks
+	unsigned short steps[SCREEN_SIZE_X];
+} frame_slices;
+
+// The state of one ray being cast. trace_ray and trace_ray_fixed each keep their own on the stack instead of
+// sharing globals, so rays can be cast on several cores at once
+typedef struct ray_context {
+	int player_x;
+	int player_y;
+	// binary angle of the ray, 0 - ANGLE_UNITS, see column_ray_angle
+	int angle;
+	// the same angle in degrees (0 - 360), only filled in by the double path
+	double alpha;
+	// steps of the DDA loop, each into the next grid cell after any empty block skip
+	int steps;
+	// empty blocks skipped, only counted in profiled builds (see profile/profile.h)
+	int block_skips;
+} ray_context;
+
+// The DDA state of a ray being traced by the fixed point ray caster. trace_ray_fixed is start_ray_fixed followed
+// by finish_ray_fixed. The packet tracer (ray_packet.h) starts its rays the same way, steps them together, and
+// hands the ones it can't step together to finish_ray_fixed
+typedef struct fixed_ray {
+	ray_context context;
+	// direction of the ray, 10.22
+	int dir_x;
+	int dir_y;
+	// the grid cell the ray is in, and the direction it moves to the next cell in x and y
+	grid_point cell;
+	int step_x;
+	int step_y;
+	// as in trace_ray, in 16.16 grid cells. INT_MAX for a ray parallel to those grid lines
+	int delta_x;
+	int delta_y;
+	int side_x;
+	int side_y;
+} fixed_ray;
+
+// Where a ray hit, before the fishbowl effect is reversed for the screen column it's drawn in. A ray at the same
+// angle from the same position hits the same place whichever column it's in, so a hit can be drawn in another
+// column after the player turns (see ray_cache.h)
+typedef struct ray_hit {
+	// distance along the ray, 16.16 grid cells. The floating point ray caster rounds it to the nearest
+	int distance;
+	// the wall block that was hit, cell_x = cell_y = -1 if the ray left the map
+	short int cell_x;
+	short int cell_y;
+	unsigned char face;
+	unsigned char texture_u;
+	unsigned short steps;
+} ray_hit;
+
+// the binary angle of the ray at screen_column. To get it, we shift to the left of the FOV from the player
+// angle and then subtract one RAY_ANGLE_INC per screen column
+#define column_ray_angle(player_angle, screen_column) wrap_angle((player_angle) - (screen_column) + HALF_FOV_UNITS)
+
+// fills in the integer fields of a ray context for the ray at ray_angle
+void init_ray_context(ray_context* ray, int player_x, int player_y, int ray_angle);
+
+// casts a ray for every screen column into slices, without allocating any memory.
+// Uses cast_ray_fixed if RAYCAST_FIXED_POINT is defined, cast_ray otherwise
+void cast_frame(int playerX, int playerY, int player_angle, frame_slices* slices);
+
+// casts the rays of screen columns first_column to last_column - 1 into slices, like cast_frame.
+// Safe to call from several threads at once for different columns of the same slices
+void cast_frame_columns(int playerX, int playerY, int player_angle, int first_column, int last_column, frame_slices* slices);
+
+// casts the ray at screen_column and stores its slice in slices
+void cast_ray(int playerX, int playerY, int player_angle, int screen_column, frame_slices* slices);
+
+// same as cast_ray, but uses only integer math and the precomputed tables in trig_tables.c
+void cast_ray_fixed(int playerX, int playerY, int player_angle, int screen_column, frame_slices* slices);
+
+// trace the ray at ray_angle (a binary angle) until it hits a wall or leaves the map. cast_ray and cast_ray_fixed
+// are these followed by set_hit_slice and set_hit_slice_fixed
+void trace_ray(int playerX, int playerY, int ray_angle, ray_hit* hit);
+void trace_ray_fixed(int playerX, int playerY, int ray_angle, ray_hit* hit);
+
+// sets up a fixed point ray at ray_angle from the player's cell
+void start_ray_fixed(fixed_ray* ray, int playerX, int playerY, int ray_angle);
+
+// steps a fixed point ray through the grid from where it is until it hits a wall or leaves the map
+void finish_ray_fixed(fixed_ray* ray, ray_hit* hit);
+
+// fills in the hit of a fixed point ray that reached the wall in its cell at distance, crossing face
+void set_fixed_ray_hit(fixed_ray* ray, int distance, wall_face face, ray_hit* hit);
+
+// moves a fixed point ray through the empty (1 << shift) cell block it is in to the cell it leaves the block from
+void skip_empty_block_fixed(int shift, grid_point* cell, int step_x, int step_y, int delta_x, int delta_y, int* side_x, int* side_y);
+
+// stores the slice of a hit drawn at screen_column, reversing the fishbowl effect for that column the way the
+// double or the fixed point ray caster does
+void set_hit_slice(frame_slices* slices, int screen_column, const ray_hit* hit);
+void set_hit_slice_fixed(frame_slices* slices, int screen_column, const ray_hit* hit);
+
+// ------------------------- helpers shared by the double and fixed point ray casters -------------------------
+
+// true if the grid cell is outside the map
+bool outside_map_bounds(int grid_x, int grid_y);
+
+// the offset across the face of a wall block, given the unit coordinate along the face where the ray hit it
+int wall_face_offset(wall_face face, int hit_position);
+
+// the height on screen of a wall at distance (16.16 grid cells), before it's limited to the screen height.
+// Texturing needs it to scale the texture of walls taller than the screen
+int projected_slice_size(int distance);
 
-point find_closest_horizontal_wall_intersection(int playerX, int playerY);
+// stores the slice for a wall at distance, working out its size and location on screen
+void set_slice(frame_slices* slices, int screen_column, int distance, grid_point cell, wall_face face, int offset);
 
-point find_closest_vertical_wall_intersection(int playerX, int playerY);
+// stores the slice for a ray that left the map without hitting a wall
+void set_empty_slice(frame_slices* slices, int screen_column);
 
-// if no wall exists at this ray, returns 0
-double find_closest_distance_to_wall(int playerX, int playerY, point* horiz_intersection, point* vert_intersection);
+// fills in the hit of a ray that left the map after steps steps
+void set_missed_hit(ray_hit* hit, int steps);
 
-slice_info* cast_ray(int playerX, int playerY, double player_angle, int screen_column);
+// adds the steps and block skips of a finished ray to the profiler's counters. Only in profiled builds
+void count_ray_steps(ray_context* ray);
 
-#endif // RAYCAST_H
\ No newline at end of file
+#endif // RAYCAST_H
@@ -0,0 +1,162 @@
+#include "raycast.h"
+#include "trig_tables.h"
+#include "map_grid.h"
+#include "../profile/profile.h"
+
+// Integer-only version of raycast.c. The DDA is the same, with cosd / sind replaced by table lookups and
+// the divisions by cos / sin replaced by the sec table. Distances are 16.16 grid cells throughout.
+
+static inline void skip_empty_block(int shift, grid_point* cell, int step_x, int step_y, int delta_x, int delta_y, int* side_x, int* side_y);
+
+void cast_ray_fixed(int playerX, int playerY, int player_angle, int screen_column, frame_slices* slices) {
+	ray_hit hit;
+	trace_ray_fixed(playerX, playerY, column_ray_angle(player_angle, screen_column), &hit);
+	set_hit_slice_fixed(slices, screen_column, &hit);
+}
+
+void trace_ray_fixed(int playerX, int playerY, int ray_angle, ray_hit* hit) {
+	fixed_ray ray;
+	start_ray_fixed(&ray, playerX, playerY, ray_angle);
+	finish_ray_fixed(&ray, hit);
+}
+
+void start_ray_fixed(fixed_ray* ray, int playerX, int playerY, int ray_angle) {
+	init_ray_context(&ray->context, playerX, playerY, ray_angle);
+
+	// direction of the ray, 10.22. The y axis is flipped, so a ray facing up travels towards -y
+	ray->dir_x = fixed_cos(ray_angle);
+	ray->dir_y = -fixed_sin(ray_angle);
+
+	ray->cell.x = playerX >> 6;
+	ray->cell.y = playerY >> 6;
+	ray->step_x = (ray->dir_x < 0) ? -1 : 1;
+	ray->step_y = (ray->dir_y < 0) ? -1 : 1;
+
+	// distance travelled per grid cell in x and y, 1 / |cos| and 1 / |sin|. They saturate at INT_MAX when the
+	// ray is parallel to the grid lines, and are then never reached
+	int sec_x = SEC_TABLE[ray_angle];
+	int sec_y = SEC_TABLE[wrap_angle(ray_angle - ANGLE_UNITS / 4)];
+
+	// delta and side are as in cast_ray, in 16.16 grid cells. The player's position within its cell is
+	// shifted from unit coordinates (1/64 of a cell) to 16.16 grid cells
+	ray->delta_x = INT_MAX;
+	ray->delta_y = INT_MAX;
+	ray->side_x = INT_MAX;
+	ray->side_y = INT_MAX;
+	if (sec_x != INT_MAX) {
+		ray->delta_x = sec_x >> (TABLE_SHIFT - FIXED_SHIFT);
+		int to_grid_line = (ray->dir_x < 0) ? playerX - ray->cell.x * 64 : (ray->cell.x + 1) * 64 - playerX;
+		ray->side_x = ((long long)to_grid_line * sec_x) >> (TABLE_SHIFT - FIXED_SHIFT + 6);
+	}
+	if (sec_y != INT_MAX) {
+		ray->delta_y = sec_y >> (TABLE_SHIFT - FIXED_SHIFT);
+		int to_grid_line = (ray->dir_y < 0) ? playerY - ray->cell.y * 64 : (ray->cell.y + 1) * 64 - playerY;
+		ray->side_y = ((long long)to_grid_line * sec_y) >> (TABLE_SHIFT - FIXED_SHIFT + 6);
+	}
+}
+
+void finish_ray_fixed(fixed_ray* ray, ray_hit* hit) {
+	// the DDA state in locals, so it stays in registers
+	grid_point cell = ray->cell;
+	int step_x = ray->step_x, step_y = ray->step_y;
+	int delta_x = ray->delta_x, delta_y = ray->delta_y, side_x = ray->side_x, side_y = ray->side_y;
+
+	int distance;
+	wall_face face;
+	// the pyramid is only looked up in cells inside the map, see cast_ray
+	int shift = outside_map_bounds(cell.x, cell.y) ? 0 : map_empty_block_shift(cell.x, cell.y);
+	while (true) {
+		// in an empty block of the map pyramid, jump to the last cell before the ray leaves the block
+		if (shift > 0) {
+			PROFILE_ONLY(ray->context.block_skips++);
+			skip_empty_block(shift, &cell, step_x, step_y, delta_x, delta_y, &side_x, &side_y);
+		}
+
+		if (side_x < side_y) {
+			distance = side_x;
+			side_x += delta_x;
+			cell.x += step_x;
+			face = (step_x > 0) ? FACE_WEST : FACE_EAST;
+		} else {
+			distance = side_y;
+			side_y += delta_y;
+			cell.y += step_y;
+			face = (step_y > 0) ? FACE_NORTH : FACE_SOUTH;
+		}
+		ray->context.steps++;
+
+		if (outside_map_bounds(cell.x, cell.y)) {
+			set_missed_hit(hit, ray->context.steps);
+			PROFILE_ONLY(count_ray_steps(&ray->context));
+			return;
+		} else if (map_cell_solid(cell.x, cell.y)) {
+			break;
+		}
+		shift = map_empty_block_shift(cell.x, cell.y);
+	}
+
+	ray->cell = cell;
+	set_fixed_ray_hit(ray, distance, face, hit);
+}
+
+void set_fixed_ray_hit(fixed_ray* ray, int distance, wall_face face, ray_hit* hit) {
+	// distance * direction is in grid cells with 16 + 22 fractional bits, shifted to whole unit coordinates
+	int hit_position = (face == FACE_WEST || face == FACE_EAST) ?
+		ray->context.player_y + (int)(((long long)distance * ray->dir_y) >> (FIXED_SHIFT + TABLE_SHIFT - 6)) :
+		ray->context.player_x + (int)(((long long)distance * ray->dir_x) >> (FIXED_SHIFT + TABLE_SHIFT - 6));
+
+	hit->distance = distance;
+	hit->cell_x = ray->cell.x;
+	hit->cell_y = ray->cell.y;
+	hit->face = face;
+	hit->texture_u = wall_face_offset(face, hit_position);
+	hit->steps = ray->context.steps;
+	PROFILE_ONLY(count_ray_steps(&ray->context));
+}
+
+void set_hit_slice_fixed(frame_slices* slices, int screen_column, const ray_hit* hit) {
+	if (hit->cell_x < 0) {
+		set_empty_slice(slices, screen_column);
+	} else {
+		// reverse fishbowl the distance using the cos for this column
+		int perpendicular_distance = ((long long)hit->distance * FISHBOWL_TABLE[screen_column]) >> TABLE_SHIFT;
+		grid_point cell = { hit->cell_x, hit->cell_y };
+		set_slice(slices, screen_column, perpendicular_distance, cell, hit->face, hit->texture_u);
+	}
+	slices->steps[screen_column] = hit->steps;
+}
+
+// Moves the ray through the empty (1 << shift) cell block it is in to the cell it leaves the block from, with the
+// same side distances the DDA loop would have after stepping there one cell at a time. The next step of the
+// loop then leaves the block. A ray parallel to one set of grid lines never crosses them, as in the loop
+static inline void skip_empty_block(int shift, grid_point* cell, int step_x, int step_y, int delta_x, int delta_y, int* side_x, int* side_y) {
+
+	// the number of grid lines the ray crosses in x and y until it leaves the block
+	int block_x = cell->x & -(1 << shift), block_y = cell->y & -(1 << shift);
+	int crossings_x = (step_x > 0) ? block_x + (1 << shift) - cell->x : cell->x - block_x + 1;
+	int crossings_y = (step_y > 0) ? block_y + (1 << shift) - cell->y : cell->y - block_y + 1;
+
+	// the distances at which the ray leaves the block through a vertical and through a horizontal grid line
+	long long exit_x = *side_x + (long long)(crossings_x - 1) * delta_x;
+	long long exit_y = *side_y + (long long)(crossings_y - 1) * delta_y;
+
+	// the loop takes the crossing with the smaller distance, and the horizontal grid line on a tie. Count the
+	// crossings of the other set of grid lines the loop takes before the one that leaves the block
+	long long steps_x, steps_y;
+	if (exit_x < exit_y) {
+		steps_x = crossings_x - 1;
+		steps_y = (*side_y <= exit_x) ? (exit_x - *side_y) / delta_y + 1 : 0;
+	} else {
+		steps_y = crossings_y - 1;
+		steps_x = (*side_x < exit_y) ? (exit_y - *side_x + delta_x - 1) / delta_x : 0;
+	}
+
+	cell->x += step_x * steps_x;
+	cell->y += step_y * steps_y;
+	*side_x += steps_x * delta_x;
+	*side_y += steps_y * delta_y;
+}
+
+void skip_empty_block_fixed(int shift, grid_point* cell, int step_x, int step_y, int delta_x, int delta_y, int* side_x, int* side_y) {
+	skip_empty_block(shift, cell, step_x, step_y, delta_x, delta_y, side_x, side_y);
+}
@@ -0,0 +1,533 @@
+// generated by gen_trig_tables.c, do not edit
+
+#include "trig_tables.h"
+
+const int COS_TABLE[1920] = {
+	4194304, 4194282, 4194214, 4194102, 4193945, 4193743, 4193496, 4193204,
+	4192867, 4192485, 4192058, 4191587, 4191070, 4190509, 4189903, 4189252,
+	4188556, 4187815, 4187029, 4186199, 4185324, 4184404, 4183439, 4182429,
+	4181374, 4180275, 4179131, 4177942, 4176709, 4175430, 4174107, 4172740,
+	4171327, 4169870, 4168368, 4166822, 4165231, 4163595, 4161915, 4160190,
+	4158421, 4156607, 4154749, 4152846, 4150899, 4148907, 4146871, 4144790,
+	4142665, 4140496, 4138282, 4136024, 4133722, 4131375, 4128984, 4126549,
+	4124070, 4121547, 4118979, 4116367, 4113712, 4111012, 4108268, 4105480,
+	4102648, 4099773, 4096853, 4093890, 4090882, 4087831, 4084736, 4081597,
+	4078415, 4075189, 4071919, 4068606, 4065249, 4061849, 4058405, 4054917,
+	4051387, 4047812, 4044195, 4040534, 4036830, 4033082, 4029292, 4025458,
+	4021581, 4017662, 4013699, 4009693, 4005644, 4001552, 3997418, 3993240,
+	3989020, 3984757, 3980452, 3976104, 3971713, 3967280, 3962804, 3958286,
+	3953725, 3949122, 3944477, 3939789, 3935060, 3930288, 3925474, 3920618,
+	3915720, 3910780, 3905799, 3900775, 3895710, 3890603, 3885454, 3880264,
+	3875032, 3869758, 3864443, 3859087, 3853690, 3848251, 3842771, 3837250,
+	3831687, 3826084, 3820440, 3814755, 3809029, 3803262, 3797454, 3791606,
+	3785717, 3779788, 3773818, 3767808, 3761757, 3755666, 3749535, 3743364,
+	3737152, 3730901, 3724609, 3718278, 3711907, 3705496, 3699046, 3692556,
+	3686026, 3679457, 3672848, 3666201, 3659513, 3652787, 3646022, 3639217,
+	3632374, 3625491, 3618570, 3611610, 3604612, 3597575, 3590499, 3583385,
+	3576232, 3569041, 3561812, 3554545, 3547240, 3539896, 3532515, 3525096,
+	3517639, 3510145, 3502613, 3495043, 3487436, 3479792, 3472110, 3464392,
+	3456636, 3448843, 3441013, 3433146, 3425243, 3417303, 3409326, 3401313,
+	3393263, 3385177, 3377055, 3368897, 3360702, 3352472, 3344205, 3335903,
+	3327565, 3319192, 3310782, 3302338, 3293858, 3285343, 3276792, 3268207,
+	3259586, 3250931, 3242241, 3233516, 3224756, 3215962, 3207134, 3198271,
+	3189374, 3180443, 3171477, 3162478, 3153445, 3144378, 3135277, 3126143,
+	3116975, 3107774, 3098540, 3089272, 3079972, 3070638, 3061272, 3051873,
+	3042441, 3032976, 3023479, 3013950, 3004388, 2994794, 2985168, 2975511,
+	2965821, 2956099, 2946346, 2936561, 2926745, 2916898, 2907019, 2897109,
+	2887168, 2877197, 2867194, 2857161, 2847097, 2837002, 2826877, 2816722,
+	2806537, 2796322, 2786077, 2775802, 2765497, 2755162, 2744798, 2734405,
+	2723983, 2713531, 2703050, 2692540, 2682002, 2671434, 2660838, 2650214,
+	2639561, 2628880, 2618171, 2607433, 2596668, 2585875, 2575055, 2564206,
+	2553330, 2542427, 2531497, 2520540, 2509555, 2498544, 2487506, 2476441,
+	2465350, 2454232, 2443089, 2431918, 2420722, 2409500, 2398253, 2386979,
+	2375680, 2364355, 2353006, 2341631, 2330230, 2318805, 2307355, 2295881,
+	2284382, 2272858, 2261310, 2249738, 2238141, 2226521, 2214877, 2203209,
+	2191518, 2179803, 2168065, 2156303, 2144519, 2132711, 2120881, 2109028,
+	2097152, 2085254, 2073333, 2061391, 2049426, 2037439, 2025431, 2013401,
+	2001349, 1989276, 1977181, 1965066, 1952929, 1940771, 1928593, 1916394,
+	1904174, 1891934, 1879674, 1867394, 1855093, 1842773, 1830433, 1818073,
+	1805694, 1793296, 1780878, 1768442, 1755986, 1743512, 1731019, 1718507,
+	1705977, 1693429, 1680862, 1668278, 1655676, 1643056, 1630418, 1617763,
+	1605091, 1592401, 1579694, 1566971, 1554231, 1541474, 1528700, 1515910,
+	1503104, 1490282, 1477444, 1464590, 1451720, 1438835, 1425934, 1413018,
+	1400087, 1387141, 1374181, 1361205, 1348215, 1335210, 1322191, 1309158,
+	1296111, 1283050, 1269976, 1256887, 1243786, 1230670, 1217542, 1204401,
+	1191247, 1178080, 1164900, 1151708, 1138504, 1125287, 1112059, 1098818,
+	1085566, 1072302, 1059026, 1045740, 1032442, 1019133, 1005813, 992482,
+	979141, 965789, 952427, 939055, 925672, 912280, 898878, 885466,
+	872045, 858614, 845175, 831726, 818268, 804802, 791327, 777843,
+	764351, 750851, 737343, 723827, 710303, 696772, 683233, 669687,
+	656134, 642573, 629006, 615432, 601852, 588265, 574671, 561072,
+	547467, 533855, 520238, 506616, 492988, 479354, 465716, 452072,
+	438424, 424771, 411114, 397452, 383786, 370115, 356441, 342763,
+	329081, 315396, 301707, 288016, 274321, 260623, 246922, 233219,
+	219513, 205805, 192094, 178382, 164668, 150951, 137234, 123515,
+	109794, 96072, 82350, 68626, 54902, 41177, 27451, 13726,
+	0, -13726, -27451, -41177, -54902, -68626, -82350, -96072,
+	-109794, -123515, -137234, -150951, -164668, -178382, -192094, -205805,
+	-219513, -233219, -246922, -260623, -274321, -288016, -301707, -315396,
+	-329081, -342763, -356441, -370115, -383786, -397452, -411114, -424771,
+	-438424, -452072, -465716, -479354, -492988, -506616, -520238, -533855,
+	-547467, -561072, -574671, -588265, -601852, -615432, -629006, -642573,
+	-656134, -669687, -683233, -696772, -710303, -723827, -737343, -750851,
+	-764351, -777843, -791327, -804802, -818268, -831726, -845175, -858614,
+	-872045, -885466, -898878, -912280, -925672, -939055, -952427, -965789,
+	-979141, -992482, -1005813, -1019133, -1032442, -1045740, -1059026, -1072302,
+	-1085566, -1098818, -1112059, -1125287, -1138504, -1151708, -1164900, -1178080,
+	-1191247, -1204401, -1217542, -1230670, -1243786, -1256887, -1269976, -1283050,
+	-1296111, -1309158, -1322191, -1335210, -1348215, -1361205, -1374181, -1387141,
+	-1400087, -1413018, -1425934, -1438835, -1451720, -1464590, -1477444, -1490282,
+	-1503104, -1515910, -1528700, -1541474, -1554231, -1566971, -1579694, -1592401,
+	-1605091, -1617763, -1630418, -1643056, -1655676, -1668278, -1680862, -1693429,
+	-1705977, -1718507, -1731019, -1743512, -1755986, -1768442, -1780878, -1793296,
+	-1805694, -1818073, -1830433, -1842773, -1855093, -1867394, -1879674, -1891934,
+	-1904174, -1916394, -1928593, -1940771, -1952929, -1965066, -1977181, -1989276,
+	-2001349, -2013401, -2025431, -2037439, -2049426, -2061391, -2073333, -2085254,
+	-2097152, -2109028, -2120881, -2132711, -2144519, -2156303, -2168065, -2179803,
+	-2191518, -2203209, -2214877, -2226521, -2238141, -2249738, -2261310, -2272858,
+	-2284382, -2295881, -2307355, -2318805, -2330230, -2341631, -2353006, -2364355,
+	-2375680, -2386979, -2398253, -2409500, -2420722, -2431918, -2443089, -2454232,
+	-2465350, -2476441, -2487506, -2498544, -2509555, -2520540, -2531497, -2542427,
+	-2553330, -2564206, -2575055, -2585875, -2596668, -2607433, -2618171, -2628880,
+	-2639561, -2650214, -2660838, -2671434, -2682002, -2692540, -2703050, -2713531,
+	-2723983, -2734405, -2744798, -2755162, -2765497, -2775802, -2786077, -2796322,
+	-2806537, -2816722, -2826877, -2837002, -2847097, -2857161, -2867194, -2877197,
+	-2887168, -2897109, -2907019, -2916898, -2926745, -2936561, -2946346, -2956099,
+	-2965821, -2975511, -2985168, -2994794, -3004388, -3013950, -3023479, -3032976,
+	-3042441, -3051873, -3061272, -3070638, -3079972, -3089272, -3098540, -3107774,
+	-3116975, -3126143, -3135277, -3144378, -3153445, -3162478, -3171477, -3180443,
+	-3189374, -3198271, -3207134, -3215962, -3224756, -3233516, -3242241, -3250931,
+	-3259586, -3268207, -3276792, -3285343, -3293858, -3302338, -3310782, -3319192,
+	-3327565, -3335903, -3344205, -3352472, -3360702, -3368897, -3377055, -3385177,
+	-3393263, -3401313, -3409326, -3417303, -3425243, -3433146, -3441013, -3448843,
+	-3456636, -3464392, -3472110, -3479792, -3487436, -3495043, -3502613, -3510145,
+	-3517639, -3525096, -3532515, -3539896, -3547240, -3554545, -3561812, -3569041,
+	-3576232, -3583385, -3590499, -3597575, -3604612, -3611610, -3618570, -3625491,
+	-3632374, -3639217, -3646022, -3652787, -3659513, -3666201, -3672848, -3679457,
+	-3686026, -3692556, -3699046, -3705496, -3711907, -3718278, -3724609, -3730901,
+	-3737152, -3743364, -3749535, -3755666, -3761757, -3767808, -3773818, -3779788,
+	-3785717, -3791606, -3797454, -3803262, -3809029, -3814755, -3820440, -3826084,
+	-3831687, -3837250, -3842771, -3848251, -3853690, -3859087, -3864443, -3869758,
+	-3875032, -3880264, -3885454, -3890603, -3895710, -3900775, -3905799, -3910780,
+	-3915720, -3920618, -3925474, -3930288, -3935060, -3939789, -3944477, -3949122,
+	-3953725, -3958286, -3962804, -3967280, -3971713, -3976104, -3980452, -3984757,
+	-3989020, -3993240, -3997418, -4001552, -4005644, -4009693, -4013699, -4017662,
+	-4021581, -4025458, -4029292, -4033082, -4036830, -4040534, -4044195, -4047812,
+	-4051387, -4054917, -4058405, -4061849, -4065249, -4068606, -4071919, -4075189,
+	-4078415, -4081597, -4084736, -4087831, -4090882, -4093890, -4096853, -4099773,
+	-4102648, -4105480, -4108268, -4111012, -4113712, -4116367, -4118979, -4121547,
+	-4124070, -4126549, -4128984, -4131375, -4133722, -4136024, -4138282, -4140496,
+	-4142665, -4144790, -4146871, -4148907, -4150899, -4152846, -4154749, -4156607,
+	-4158421, -4160190, -4161915, -4163595, -4165231, -4166822, -4168368, -4169870,
+	-4171327, -4172740, -4174107, -4175430, -4176709, -4177942, -4179131, -4180275,
+	-4181374, -4182429, -4183439, -4184404, -4185324, -4186199, -4187029, -4187815,
+	-4188556, -4189252, -4189903, -4190509, -4191070, -4191587, -4192058, -4192485,
+	-4192867, -4193204, -4193496, -4193743, -4193945, -4194102, -4194214, -4194282,
+	-4194304, -4194282, -4194214, -4194102, -4193945, -4193743, -4193496, -4193204,
+	-4192867, -4192485, -4192058, -4191587, -4191070, -4190509, -4189903, -4189252,
+	-4188556, -4187815, -4187029, -4186199, -4185324, -4184404, -4183439, -4182429,
+	-4181374, -4180275, -4179131, -4177942, -4176709, -4175430, -4174107, -4172740,
+	-4171327, -4169870, -4168368, -4166822, -4165231, -4163595, -4161915, -4160190,
+	-4158421, -4156607, -4154749, -4152846, -4150899, -4148907, -4146871, -4144790,
+	-4142665, -4140496, -4138282, -4136024, -4133722, -4131375, -4128984, -4126549,
+	-4124070, -4121547, -4118979, -4116367, -4113712, -4111012, -4108268, -4105480,
+	-4102648, -4099773, -4096853, -4093890, -4090882, -4087831, -4084736, -4081597,
+	-4078415, -4075189, -4071919, -4068606, -4065249, -4061849, -4058405, -4054917,
+	-4051387, -4047812, -4044195, -4040534, -4036830, -4033082, -4029292, -4025458,
+	-4021581, -4017662, -4013699, -4009693, -4005644, -4001552, -3997418, -3993240,
+	-3989020, -3984757, -3980452, -3976104, -3971713, -3967280, -3962804, -3958286,
+	-3953725, -3949122, -3944477, -3939789, -3935060, -3930288, -3925474, -3920618,
+	-3915720, -3910780, -3905799, -3900775, -3895710, -3890603, -3885454, -3880264,
+	-3875032, -3869758, -3864443, -3859087, -3853690, -3848251, -3842771, -3837250,
+	-3831687, -3826084, -3820440, -3814755, -3809029, -3803262, -3797454, -3791606,
+	-3785717, -3779788, -3773818, -3767808, -3761757, -3755666, -3749535, -3743364,
+	-3737152, -3730901, -3724609, -3718278, -3711907, -3705496, -3699046, -3692556,
+	-3686026, -3679457, -3672848, -3666201, -3659513, -3652787, -3646022, -3639217,
+	-3632374, -3625491, -3618570, -3611610, -3604612, -3597575, -3590499, -3583385,
+	-3576232, -3569041, -3561812, -3554545, -3547240, -3539896, -3532515, -3525096,
+	-3517639, -3510145, -3502613, -3495043, -3487436, -3479792, -3472110, -3464392,
+	-3456636, -3448843, -3441013, -3433146, -3425243, -3417303, -3409326, -3401313,
+	-3393263, -3385177, -3377055, -3368897, -3360702, -3352472, -3344205, -3335903,
+	-3327565, -3319192, -3310782, -3302338, -3293858, -3285343, -3276792, -3268207,
+	-3259586, -3250931, -3242241, -3233516, -3224756, -3215962, -3207134, -3198271,
+	-3189374, -3180443, -3171477, -3162478, -3153445, -3144378, -3135277, -3126143,
+	-3116975, -3107774, -3098540, -3089272, -3079972, -3070638, -3061272, -3051873,
+	-3042441, -3032976, -3023479, -3013950, -3004388, -2994794, -2985168, -2975511,
+	-2965821, -2956099, -2946346, -2936561, -2926745, -2916898, -2907019, -2897109,
+	-2887168, -2877197, -2867194, -2857161, -2847097, -2837002, -2826877, -2816722,
+	-2806537, -2796322, -2786077, -2775802, -2765497, -2755162, -2744798, -2734405,
+	-2723983, -2713531, -2703050, -2692540, -2682002, -2671434, -2660838, -2650214,
+	-2639561, -2628880, -2618171, -2607433, -2596668, -2585875, -2575055, -2564206,
+	-2553330, -2542427, -2531497, -2520540, -2509555, -2498544, -2487506, -2476441,
+	-2465350, -2454232, -2443089, -2431918, -2420722, -2409500, -2398253, -2386979,
+	-2375680, -2364355, -2353006, -2341631, -2330230, -2318805, -2307355, -2295881,
+	-2284382, -2272858, -2261310, -2249738, -2238141, -2226521, -2214877, -2203209,
+	-2191518, -2179803, -2168065, -2156303, -2144519, -2132711, -2120881, -2109028,
+	-2097152, -2085254, -2073333, -2061391, -2049426, -2037439, -2025431, -2013401,
+	-2001349, -1989276, -1977181, -1965066, -1952929, -1940771, -1928593, -1916394,
+	-1904174, -1891934, -1879674, -1867394, -1855093, -1842773, -1830433, -1818073,
+	-1805694, -1793296, -1780878, -1768442, -1755986, -1743512, -1731019, -1718507,
+	-1705977, -1693429, -1680862, -1668278, -1655676, -1643056, -1630418, -1617763,
+	-1605091, -1592401, -1579694, -1566971, -1554231, -1541474, -1528700, -1515910,
+	-1503104, -1490282, -1477444, -1464590, -1451720, -1438835, -1425934, -1413018,
+	-1400087, -1387141, -1374181, -1361205, -1348215, -1335210, -1322191, -1309158,
+	-1296111, -1283050, -1269976, -1256887, -1243786, -1230670, -1217542, -1204401,
+	-1191247, -1178080, -1164900, -1151708, -1138504, -1125287, -1112059, -1098818,
+	-1085566, -1072302, -1059026, -1045740, -1032442, -1019133, -1005813, -992482,
+	-979141, -965789, -952427, -939055, -925672, -912280, -898878, -885466,
+	-872045, -858614, -845175, -831726, -818268, -804802, -791327, -777843,
+	-764351, -750851, -737343, -723827, -710303, -696772, -683233, -669687,
+	-656134, -642573, -629006, -615432, -601852, -588265, -574671, -561072,
+	-547467, -533855, -520238, -506616, -492988, -479354, -465716, -452072,
+	-438424, -424771, -411114, -397452, -383786, -370115, -356441, -342763,
+	-329081, -315396, -301707, -288016, -274321, -260623, -246922, -233219,
+	-219513, -205805, -192094, -178382, -164668, -150951, -137234, -123515,
+	-109794, -96072, -82350, -68626, -54902, -41177, -27451, -13726,
+	0, 13726, 27451, 41177, 54902, 68626, 82350, 96072,
+	109794, 123515, 137234, 150951, 164668, 178382, 192094, 205805,
+	219513, 233219, 246922, 260623, 274321, 288016, 301707, 315396,
+	329081, 342763, 356441, 370115, 383786, 397452, 411114, 424771,
+	438424, 452072, 465716, 479354, 492988, 506616, 520238, 533855,
+	547467, 561072, 574671, 588265, 601852, 615432, 629006, 642573,
+	656134, 669687, 683233, 696772, 710303, 723827, 737343, 750851,
+	764351, 777843, 791327, 804802, 818268, 831726, 845175, 858614,
+	872045, 885466, 898878, 912280, 925672, 939055, 952427, 965789,
+	979141, 992482, 1005813, 1019133, 1032442, 1045740, 1059026, 1072302,
+	1085566, 1098818, 1112059, 1125287, 1138504, 1151708, 1164900, 1178080,
+	1191247, 1204401, 1217542, 1230670, 1243786, 1256887, 1269976, 1283050,
+	1296111, 1309158, 1322191, 1335210, 1348215, 1361205, 1374181, 1387141,
+	1400087, 1413018, 1425934, 1438835, 1451720, 1464590, 1477444, 1490282,
+	1503104, 1515910, 1528700, 1541474, 1554231, 1566971, 1579694, 1592401,
+	1605091, 1617763, 1630418, 1643056, 1655676, 1668278, 1680862, 1693429,
+	1705977, 1718507, 1731019, 1743512, 1755986, 1768442, 1780878, 1793296,
+	1805694, 1818073, 1830433, 1842773, 1855093, 1867394, 1879674, 1891934,
+	1904174, 1916394, 1928593, 1940771, 1952929, 1965066, 1977181, 1989276,
+	2001349, 2013401, 2025431, 2037439, 2049426, 2061391, 2073333, 2085254,
+	2097152, 2109028, 2120881, 2132711, 2144519, 2156303, 2168065, 2179803,
+	2191518, 2203209, 2214877, 2226521, 2238141, 2249738, 2261310, 2272858,
+	2284382, 2295881, 2307355, 2318805, 2330230, 2341631, 2353006, 2364355,
+	2375680, 2386979, 2398253, 2409500, 2420722, 2431918, 2443089, 2454232,
+	2465350, 2476441, 2487506, 2498544, 2509555, 2520540, 2531497, 2542427,
+	2553330, 2564206, 2575055, 2585875, 2596668, 2607433, 2618171, 2628880,
+	2639561, 2650214, 2660838, 2671434, 2682002, 2692540, 2703050, 2713531,
+	2723983, 2734405, 2744798, 2755162, 2765497, 2775802, 2786077, 2796322,
+	2806537, 2816722, 2826877, 2837002, 2847097, 2857161, 2867194, 2877197,
+	2887168, 2897109, 2907019, 2916898, 2926745, 2936561, 2946346, 2956099,
+	2965821, 2975511, 2985168, 2994794, 3004388, 3013950, 3023479, 3032976,
+	3042441, 3051873, 3061272, 3070638, 3079972, 3089272, 3098540, 3107774,
+	3116975, 3126143, 3135277, 3144378, 3153445, 3162478, 3171477, 3180443,
+	3189374, 3198271, 3207134, 3215962, 3224756, 3233516, 3242241, 3250931,
+	3259586, 3268207, 3276792, 3285343, 3293858, 3302338, 3310782, 3319192,
+	3327565, 3335903, 3344205, 3352472, 3360702, 3368897, 3377055, 3385177,
+	3393263, 3401313, 3409326, 3417303, 3425243, 3433146, 3441013, 3448843,
+	3456636, 3464392, 3472110, 3479792, 3487436, 3495043, 3502613, 3510145,
+	3517639, 3525096, 3532515, 3539896, 3547240, 3554545, 3561812, 3569041,
+	3576232, 3583385, 3590499, 3597575, 3604612, 3611610, 3618570, 3625491,
+	3632374, 3639217, 3646022, 3652787, 3659513, 3666201, 3672848, 3679457,
+	3686026, 3692556, 3699046, 3705496, 3711907, 3718278, 3724609, 3730901,
+	3737152, 3743364, 3749535, 3755666, 3761757, 3767808, 3773818, 3779788,
+	3785717, 3791606, 3797454, 3803262, 3809029, 3814755, 3820440, 3826084,
+	3831687, 3837250, 3842771, 3848251, 3853690, 3859087, 3864443, 3869758,
+	3875032, 3880264, 3885454, 3890603, 3895710, 3900775, 3905799, 3910780,
+	3915720, 3920618, 3925474, 3930288, 3935060, 3939789, 3944477, 3949122,
+	3953725, 3958286, 3962804, 3967280, 3971713, 3976104, 3980452, 3984757,
+	3989020, 3993240, 3997418, 4001552, 4005644, 4009693, 4013699, 4017662,
+	4021581, 4025458, 4029292, 4033082, 4036830, 4040534, 4044195, 4047812,
+	4051387, 4054917, 4058405, 4061849, 4065249, 4068606, 4071919, 4075189,
+	4078415, 4081597, 4084736, 4087831, 4090882, 4093890, 4096853, 4099773,
+	4102648, 4105480, 4108268, 4111012, 4113712, 4116367, 4118979, 4121547,
+	4124070, 4126549, 4128984, 4131375, 4133722, 4136024, 4138282, 4140496,
+	4142665, 4144790, 4146871, 4148907, 4150899, 4152846, 4154749, 4156607,
+	4158421, 4160190, 4161915, 4163595, 4165231, 4166822, 4168368, 4169870,
+	4171327, 4172740, 4174107, 4175430, 4176709, 4177942, 4179131, 4180275,
+	4181374, 4182429, 4183439, 4184404, 4185324, 4186199, 4187029, 4187815,
+	4188556, 4189252, 4189903, 4190509, 4191070, 4191587, 4192058, 4192485,
+	4192867, 4193204, 4193496, 4193743, 4193945, 4194102, 4194214, 4194282,
+};
+
+const int SEC_TABLE[1920] = {
+	4194304, 4194326, 4194394, 4194506, 4194663, 4194866, 4195113, 4195405,
+	4195742, 4196124, 4196551, 4197023, 4197540, 4198102, 4198710, 4199362,
+	4200060, 4200803, 4201591, 4202425, 4203304, 4204228, 4205198, 4206213,
+	4207274, 4208380, 4209532, 4210730, 4211974, 4213263, 4214598, 4215980,
+	4217407, 4218881, 4220401, 4221967, 4223580, 4225239, 4226945, 4228697,
+	4230496, 4232343, 4234236, 4236176, 4238163, 4240198, 4242280, 4244409,
+	4246587, 4248811, 4251084, 4253405, 4255774, 4258191, 4260657, 4263171,
+	4265734, 4268346, 4271006, 4273716, 4276475, 4279284, 4282142, 4285050,
+	4288007, 4291015, 4294073, 4297181, 4300340, 4303550, 4306811, 4310123,
+	4313486, 4316901, 4320367, 4323885, 4327456, 4331079, 4334754, 4338482,
+	4342263, 4346097, 4349985, 4353926, 4357921, 4361970, 4366074, 4370232,
+	4374445, 4378713, 4383036, 4387415, 4391850, 4396340, 4400888, 4405491,
+	4410152, 4414870, 4419646, 4424479, 4429370, 4434320, 4439328, 4444395,
+	4449522, 4454708, 4459954, 4465261, 4470628, 4476055, 4481544, 4487095,
+	4492708, 4498383, 4504120, 4509921, 4515785, 4521712, 4527704, 4533761,
+	4539882, 4546069, 4552321, 4558639, 4565024, 4571476, 4577995, 4584582,
+	4591237, 4597961, 4604754, 4611617, 4618549, 4625552, 4632626, 4639772,
+	4646989, 4654279, 4661642, 4669078, 4676588, 4684172, 4691832, 4699566,
+	4707377, 4715265, 4723230, 4731272, 4739393, 4747592, 4755871, 4764230,
+	4772670, 4781191, 4789794, 4798479, 4807247, 4816099, 4825036, 4834058,
+	4843165, 4852359, 4861640, 4871009, 4880466, 4890013, 4899650, 4909377,
+	4919196, 4929107, 4939111, 4949209, 4959402, 4969690, 4980074, 4990555,
+	5001134, 5011812, 5022589, 5033467, 5044447, 5055528, 5066713, 5078002,
+	5089395, 5100895, 5112502, 5124217, 5136040, 5147974, 5160019, 5172175,
+	5184445, 5196829, 5209328, 5221943, 5234676, 5247527, 5260498, 5273590,
+	5286804, 5300142, 5313604, 5327191, 5340906, 5354749, 5368722, 5382825,
+	5397061, 5411430, 5425934, 5440575, 5455354, 5470271, 5485330, 5500530,
+	5515875, 5531364, 5547001, 5562785, 5578720, 5594807, 5611047, 5627441,
+	5643993, 5660703, 5677573, 5694605, 5711801, 5729163, 5746692, 5764391,
+	5782261, 5800305, 5818524, 5836921, 5855497, 5874255, 5893197, 5912325,
+	5931642, 5951149, 5970848, 5990743, 6010836, 6031129, 6051624, 6072324,
+	6093232, 6114350, 6135681, 6157227, 6178991, 6200977, 6223187, 6245623,
+	6268289, 6291188, 6314322, 6337696, 6361311, 6385172, 6409282, 6433643,
+	6458259, 6483135, 6508273, 6533676, 6559350, 6585296, 6611520, 6638025,
+	6664815, 6691894, 6719266, 6746936, 6774907, 6803184, 6831772, 6860675,
+	6889898, 6919445, 6949321, 6979531, 7010081, 7040975, 7072219, 7103817,
+	7135776, 7168101, 7200798, 7233872, 7267329, 7301176, 7335419, 7370063,
+	7405116, 7440584, 7476474, 7512793, 7549548, 7586745, 7624393, 7662499,
+	7701071, 7740117, 7779644, 7819661, 7860176, 7901198, 7942737, 7984800,
+	8027398, 8070540, 8114235, 8158494, 8203326, 8248743, 8294755, 8341373,
+	8388608, 8436472, 8484977, 8534135, 8583958, 8634459, 8685651, 8737549,
+	8790165, 8843513, 8897609, 8952468, 9008104, 9064534, 9121773, 9179839,
+	9238748, 9298519, 9359169, 9420717, 9483182, 9546583, 9610942, 9676279,
+	9742615, 9809973, 9878375, 9947846, 10018408, 10090087, 10162909, 10236900,
+	10312088, 10388500, 10466166, 10545116, 10625381, 10706993, 10789984, 10874390,
+	10960245, 11047585, 11136449, 11226875, 11318904, 11412577, 11507938, 11605032,
+	11703904, 11804603, 11907178, 12011681, 12118166, 12226688, 12337304, 12450075,
+	12565062, 12682330, 12801946, 12923980, 13048504, 13175593, 13305325, 13437784,
+	13573053, 13711221, 13852382, 13996630, 14144067, 14294799, 14448934, 14606587,
+	14767878, 14932933, 15101883, 15274865, 15452023, 15633508, 15819478, 16010099,
+	16205546, 16406002, 16611659, 16822720, 17039398, 17261918, 17490517, 17725443,
+	17966962, 18215351, 18470905, 18733934, 19004770, 19283761, 19571278, 19867714,
+	20173488, 20489044, 20814855, 21151425, 21499293, 21859033, 22231258, 22616626,
+	23015842, 23429659, 23858889, 24304405, 24767147, 25248126, 25748438, 26269266,
+	26811892, 27377708, 27968225, 28585091, 29230102, 29905222, 30612600, 31354598,
+	32133811, 32953103, 33815637, 34724920, 35684847, 36699758, 37774507, 38914531,
+	40125951, 41415676, 42791536, 44262442, 45838577, 47531633, 49355102, 51324631,
+	53458480, 55778081, 58308763, 61080681, 64130020, 67500584, 71245910, 75432133,
+	80141920, 85479984, 91580956, 98620891, 106834531, 116541976, 128191368, 142430023,
+	160228914, 183113856, 213627875, 256348417, 320430374, 427235160, 640847021, 1281687179,
+	2147483647, 1281687179, 640847021, 427235160, 320430374, 256348417, 213627875, 183113856,
+	160228914, 142430023, 128191368, 116541976, 106834531, 98620891, 91580956, 85479984,
+	80141920, 75432133, 71245910, 67500584, 64130020, 61080681, 58308763, 55778081,
+	53458480, 51324631, 49355102, 47531633, 45838577, 44262442, 42791536, 41415676,
+	40125951, 38914531, 37774507, 36699758, 35684847, 34724920, 33815637, 32953103,
+	32133811, 31354598, 30612600, 29905222, 29230102, 28585091, 27968225, 27377708,
+	26811892, 26269266, 25748438, 25248126, 24767147, 24304405, 23858889, 23429659,
+	23015842, 22616626, 22231258, 21859033, 21499293, 21151425, 20814855, 20489044,
+	20173488, 19867714, 19571278, 19283761, 19004770, 18733934, 18470905, 18215351,
+	17966962, 17725443, 17490517, 17261918, 17039398, 16822720, 16611659, 16406002,
+	16205546, 16010099, 15819478, 15633508, 15452023, 15274865, 15101883, 14932933,
+	14767878, 14606587, 14448934, 14294799, 14144067, 13996630, 13852382, 13711221,
+	13573053, 13437784, 13305325, 13175593, 13048504, 12923980, 12801946, 12682330,
+	12565062, 12450075, 12337304, 12226688, 12118166, 12011681, 11907178, 11804603,
+	11703904, 11605032, 11507938, 11412577, 11318904, 11226875, 11136449, 11047585,
+	10960245, 10874390, 10789984, 10706993, 10625381, 10545116, 10466166, 10388500,
+	10312088, 10236900, 10162909, 10090087, 10018408, 9947846, 9878375, 9809973,
+	9742615, 9676279, 9610942, 9546583, 9483182, 9420717, 9359169, 9298519,
+	9238748, 9179839, 9121773, 9064534, 9008104, 8952468, 8897609, 8843513,
+	8790165, 8737549, 8685651, 8634459, 8583958, 8534135, 8484977, 8436472,
+	8388608, 8341373, 8294755, 8248743, 8203326, 8158494, 8114235, 8070540,
+	8027398, 7984800, 7942737, 7901198, 7860176, 7819661, 7779644, 7740117,
+	7701071, 7662499, 7624393, 7586745, 7549548, 7512793, 7476474, 7440584,
+	7405116, 7370063, 7335419, 7301176, 7267329, 7233872, 7200798, 7168101,
+	7135776, 7103817, 7072219, 7040975, 7010081, 6979531, 6949321, 6919445,
+	6889898, 6860675, 6831772, 6803184, 6774907, 6746936, 6719266, 6691894,
+	6664815, 6638025, 6611520, 6585296, 6559350, 6533676, 6508273, 6483135,
+	6458259, 6433643, 6409282, 6385172, 6361311, 6337696, 6314322, 6291188,
+	6268289, 6245623, 6223187, 6200977, 6178991, 6157227, 6135681, 6114350,
+	6093232, 6072324, 6051624, 6031129, 6010836, 5990743, 5970848, 5951149,
+	5931642, 5912325, 5893197, 5874255, 5855497, 5836921, 5818524, 5800305,
+	5782261, 5764391, 5746692, 5729163, 5711801, 5694605, 5677573, 5660703,
+	5643993, 5627441, 5611047, 5594807, 5578720, 5562785, 5547001, 5531364,
+	5515875, 5500530, 5485330, 5470271, 5455354, 5440575, 5425934, 5411430,
+	5397061, 5382825, 5368722, 5354749, 5340906, 5327191, 5313604, 5300142,
+	5286804, 5273590, 5260498, 5247527, 5234676, 5221943, 5209328, 5196829,
+	5184445, 5172175, 5160019, 5147974, 5136040, 5124217, 5112502, 5100895,
+	5089395, 5078002, 5066713, 5055528, 5044447, 5033467, 5022589, 5011812,
+	5001134, 4990555, 4980074, 4969690, 4959402, 4949209, 4939111, 4929107,
+	4919196, 4909377, 4899650, 4890013, 4880466, 4871009, 4861640, 4852359,
+	4843165, 4834058, 4825036, 4816099, 4807247, 4798479, 4789794, 4781191,
+	4772670, 4764230, 4755871, 4747592, 4739393, 4731272, 4723230, 4715265,
+	4707377, 4699566, 4691832, 4684172, 4676588, 4669078, 4661642, 4654279,
+	4646989, 4639772, 4632626, 4625552, 4618549, 4611617, 4604754, 4597961,
+	4591237, 4584582, 4577995, 4571476, 4565024, 4558639, 4552321, 4546069,
+	4539882, 4533761, 4527704, 4521712, 4515785, 4509921, 4504120, 4498383,
+	4492708, 4487095, 4481544, 4476055, 4470628, 4465261, 4459954, 4454708,
+	4449522, 4444395, 4439328, 4434320, 4429370, 4424479, 4419646, 4414870,
+	4410152, 4405491, 4400888, 4396340, 4391850, 4387415, 4383036, 4378713,
+	4374445, 4370232, 4366074, 4361970, 4357921, 4353926, 4349985, 4346097,
+	4342263, 4338482, 4334754, 4331079, 4327456, 4323885, 4320367, 4316901,
+	4313486, 4310123, 4306811, 4303550, 4300340, 4297181, 4294073, 4291015,
+	4288007, 4285050, 4282142, 4279284, 4276475, 4273716, 4271006, 4268346,
+	4265734, 4263171, 4260657, 4258191, 4255774, 4253405, 4251084, 4248811,
+	4246587, 4244409, 4242280, 4240198, 4238163, 4236176, 4234236, 4232343,
+	4230496, 4228697, 4226945, 4225239, 4223580, 4221967, 4220401, 4218881,
+	4217407, 4215980, 4214598, 4213263, 4211974, 4210730, 4209532, 4208380,
+	4207274, 4206213, 4205198, 4204228, 4203304, 4202425, 4201591, 4200803,
+	4200060, 4199362, 4198710, 4198102, 4197540, 4197023, 4196551, 4196124,
+	4195742, 4195405, 4195113, 4194866, 4194663, 4194506, 4194394, 4194326,
+	4194304, 4194326, 4194394, 4194506, 4194663, 4194866, 4195113, 4195405,
+	4195742, 4196124, 4196551, 4197023, 4197540, 4198102, 4198710, 4199362,
+	4200060, 4200803, 4201591, 4202425, 4203304, 4204228, 4205198, 4206213,
+	4207274, 4208380, 4209532, 4210730, 4211974, 4213263, 4214598, 4215980,
+	4217407, 4218881, 4220401, 4221967, 4223580, 4225239, 4226945, 4228697,
+	4230496, 4232343, 4234236, 4236176, 4238163, 4240198, 4242280, 4244409,
+	4246587, 4248811, 4251084, 4253405, 4255774, 4258191, 4260657, 4263171,
+	4265734, 4268346, 4271006, 4273716, 4276475, 4279284, 4282142, 4285050,
+	4288007, 4291015, 4294073, 4297181, 4300340, 4303550, 4306811, 4310123,
+	4313486, 4316901, 4320367, 4323885, 4327456, 4331079, 4334754, 4338482,
+	4342263, 4346097, 4349985, 4353926, 4357921, 4361970, 4366074, 4370232,
+	4374445, 4378713, 4383036, 4387415, 4391850, 4396340, 4400888, 4405491,
+	4410152, 4414870, 4419646, 4424479, 4429370, 4434320, 4439328, 4444395,
+	4449522, 4454708, 4459954, 4465261, 4470628, 4476055, 4481544, 4487095,
+	4492708, 4498383, 4504120, 4509921, 4515785, 4521712, 4527704, 4533761,
+	4539882, 4546069, 4552321, 4558639, 4565024, 4571476, 4577995, 4584582,
+	4591237, 4597961, 4604754, 4611617, 4618549, 4625552, 4632626, 4639772,
+	4646989, 4654279, 4661642, 4669078, 4676588, 4684172, 4691832, 4699566,
+	4707377, 4715265, 4723230, 4731272, 4739393, 4747592, 4755871, 4764230,
+	4772670, 4781191, 4789794, 4798479, 4807247, 4816099, 4825036, 4834058,
+	4843165, 4852359, 4861640, 4871009, 4880466, 4890013, 4899650, 4909377,
+	4919196, 4929107, 4939111, 4949209, 4959402, 4969690, 4980074, 4990555,
+	5001134, 5011812, 5022589, 5033467, 5044447, 5055528, 5066713, 5078002,
+	5089395, 5100895, 5112502, 5124217, 5136040, 5147974, 5160019, 5172175,
+	5184445, 5196829, 5209328, 5221943, 5234676, 5247527, 5260498, 5273590,
+	5286804, 5300142, 5313604, 5327191, 5340906, 5354749, 5368722, 5382825,
+	5397061, 5411430, 5425934, 5440575, 5455354, 5470271, 5485330, 5500530,
+	5515875, 5531364, 5547001, 5562785, 5578720, 5594807, 5611047, 5627441,
+	5643993, 5660703, 5677573, 5694605, 5711801, 5729163, 5746692, 5764391,
+	5782261, 5800305, 5818524, 5836921, 5855497, 5874255, 5893197, 5912325,
+	5931642, 5951149, 5970848, 5990743, 6010836, 6031129, 6051624, 6072324,
+	6093232, 6114350, 6135681, 6157227, 6178991, 6200977, 6223187, 6245623,
+	6268289, 6291188, 6314322, 6337696, 6361311, 6385172, 6409282, 6433643,
+	6458259, 6483135, 6508273, 6533676, 6559350, 6585296, 6611520, 6638025,
+	6664815, 6691894, 6719266, 6746936, 6774907, 6803184, 6831772, 6860675,
+	6889898, 6919445, 6949321, 6979531, 7010081, 7040975, 7072219, 7103817,
+	7135776, 7168101, 7200798, 7233872, 7267329, 7301176, 7335419, 7370063,
+	7405116, 7440584, 7476474, 7512793, 7549548, 7586745, 7624393, 7662499,
+	7701071, 7740117, 7779644, 7819661, 7860176, 7901198, 7942737, 7984800,
+	8027398, 8070540, 8114235, 8158494, 8203326, 8248743, 8294755, 8341373,
+	8388608, 8436472, 8484977, 8534135, 8583958, 8634459, 8685651, 8737549,
+	8790165, 8843513, 8897609, 8952468, 9008104, 9064534, 9121773, 9179839,
+	9238748, 9298519, 9359169, 9420717, 9483182, 9546583, 9610942, 9676279,
+	9742615, 9809973, 9878375, 9947846, 10018408, 10090087, 10162909, 10236900,
+	10312088, 10388500, 10466166, 10545116, 10625381, 10706993, 10789984, 10874390,
+	10960245, 11047585, 11136449, 11226875, 11318904, 11412577, 11507938, 11605032,
+	11703904, 11804603, 11907178, 12011681, 12118166, 12226688, 12337304, 12450075,
+	12565062, 12682330, 12801946, 12923980, 13048504, 13175593, 13305325, 13437784,
+	13573053, 13711221, 13852382, 13996630, 14144067, 14294799, 14448934, 14606587,
+	14767878, 14932933, 15101883, 15274865, 15452023, 15633508, 15819478, 16010099,
+	16205546, 16406002, 16611659, 16822720, 17039398, 17261918, 17490517, 17725443,
+	17966962, 18215351, 18470905, 18733934, 19004770, 19283761, 19571278, 19867714,
+	20173488, 20489044, 20814855, 21151425, 21499293, 21859033, 22231258, 22616626,
+	23015842, 23429659, 23858889, 24304405, 24767147, 25248126, 25748438, 26269266,
+	26811892, 27377708, 27968225, 28585091, 29230102, 29905222, 30612600, 31354598,
+	32133811, 32953103, 33815637, 34724920, 35684847, 36699758, 37774507, 38914531,
+	40125951, 41415676, 42791536, 44262442, 45838577, 47531633, 49355102, 51324631,
+	53458480, 55778081, 58308763, 61080681, 64130020, 67500584, 71245910, 75432133,
+	80141920, 85479984, 91580956, 98620891, 106834531, 116541976, 128191368, 142430023,
+	160228914, 183113856, 213627875, 256348417, 320430374, 427235160, 640847021, 1281687179,
+	2147483647, 1281687179, 640847021, 427235160, 320430374, 256348417, 213627875, 183113856,
+	160228914, 142430023, 128191368, 116541976, 106834531, 98620891, 91580956, 85479984,
+	80141920, 75432133, 71245910, 67500584, 64130020, 61080681, 58308763, 55778081,
+	53458480, 51324631, 49355102, 47531633, 45838577, 44262442, 42791536, 41415676,
+	40125951, 38914531, 37774507, 36699758, 35684847, 34724920, 33815637, 32953103,
+	32133811, 31354598, 30612600, 29905222, 29230102, 28585091, 27968225, 27377708,
+	26811892, 26269266, 25748438, 25248126, 24767147, 24304405, 23858889, 23429659,
+	23015842, 22616626, 22231258, 21859033, 21499293, 21151425, 20814855, 20489044,
+	20173488, 19867714, 19571278, 19283761, 19004770, 18733934, 18470905, 18215351,
+	17966962, 17725443, 17490517, 17261918, 17039398, 16822720, 16611659, 16406002,
+	16205546, 16010099, 15819478, 15633508, 15452023, 15274865, 15101883, 14932933,
+	14767878, 14606587, 14448934, 14294799, 14144067, 13996630, 13852382, 13711221,
+	13573053, 13437784, 13305325, 13175593, 13048504, 12923980, 12801946, 12682330,
+	12565062, 12450075, 12337304, 12226688, 12118166, 12011681, 11907178, 11804603,
+	11703904, 11605032, 11507938, 11412577, 11318904, 11226875, 11136449, 11047585,
+	10960245, 10874390, 10789984, 10706993, 10625381, 10545116, 10466166, 10388500,
+	10312088, 10236900, 10162909, 10090087, 10018408, 9947846, 9878375, 9809973,
+	9742615, 9676279, 9610942, 9546583, 9483182, 9420717, 9359169, 9298519,
+	9238748, 9179839, 9121773, 9064534, 9008104, 8952468, 8897609, 8843513,
+	8790165, 8737549, 8685651, 8634459, 8583958, 8534135, 8484977, 8436472,
+	8388608, 8341373, 8294755, 8248743, 8203326, 8158494, 8114235, 8070540,
+	8027398, 7984800, 7942737, 7901198, 7860176, 7819661, 7779644, 7740117,
+	7701071, 7662499, 7624393, 7586745, 7549548, 7512793, 7476474, 7440584,
+	7405116, 7370063, 7335419, 7301176, 7267329, 7233872, 7200798, 7168101,
+	7135776, 7103817, 7072219, 7040975, 7010081, 6979531, 6949321, 6919445,
+	6889898, 6860675, 6831772, 6803184, 6774907, 6746936, 6719266, 6691894,
+	6664815, 6638025, 6611520, 6585296, 6559350, 6533676, 6508273, 6483135,
+	6458259, 6433643, 6409282, 6385172, 6361311, 6337696, 6314322, 6291188,
+	6268289, 6245623, 6223187, 6200977, 6178991, 6157227, 6135681, 6114350,
+	6093232, 6072324, 6051624, 6031129, 6010836, 5990743, 5970848, 5951149,
+	5931642, 5912325, 5893197, 5874255, 5855497, 5836921, 5818524, 5800305,
+	5782261, 5764391, 5746692, 5729163, 5711801, 5694605, 5677573, 5660703,
+	5643993, 5627441, 5611047, 5594807, 5578720, 5562785, 5547001, 5531364,
+	5515875, 5500530, 5485330, 5470271, 5455354, 5440575, 5425934, 5411430,
+	5397061, 5382825, 5368722, 5354749, 5340906, 5327191, 5313604, 5300142,
+	5286804, 5273590, 5260498, 5247527, 5234676, 5221943, 5209328, 5196829,
+	5184445, 5172175, 5160019, 5147974, 5136040, 5124217, 5112502, 5100895,
+	5089395, 5078002, 5066713, 5055528, 5044447, 5033467, 5022589, 5011812,
+	5001134, 4990555, 4980074, 4969690, 4959402, 4949209, 4939111, 4929107,
+	4919196, 4909377, 4899650, 4890013, 4880466, 4871009, 4861640, 4852359,
+	4843165, 4834058, 4825036, 4816099, 4807247, 4798479, 4789794, 4781191,
+	4772670, 4764230, 4755871, 4747592, 4739393, 4731272, 4723230, 4715265,
+	4707377, 4699566, 4691832, 4684172, 4676588, 4669078, 4661642, 4654279,
+	4646989, 4639772, 4632626, 4625552, 4618549, 4611617, 4604754, 4597961,
+	4591237, 4584582, 4577995, 4571476, 4565024, 4558639, 4552321, 4546069,
+	4539882, 4533761, 4527704, 4521712, 4515785, 4509921, 4504120, 4498383,
+	4492708, 4487095, 4481544, 4476055, 4470628, 4465261, 4459954, 4454708,
+	4449522, 4444395, 4439328, 4434320, 4429370, 4424479, 4419646, 4414870,
+	4410152, 4405491, 4400888, 4396340, 4391850, 4387415, 4383036, 4378713,
+	4374445, 4370232, 4366074, 4361970, 4357921, 4353926, 4349985, 4346097,
+	4342263, 4338482, 4334754, 4331079, 4327456, 4323885, 4320367, 4316901,
+	4313486, 4310123, 4306811, 4303550, 4300340, 4297181, 4294073, 4291015,
+	4288007, 4285050, 4282142, 4279284, 4276475, 4273716, 4271006, 4268346,
+	4265734, 4263171, 4260657, 4258191, 4255774, 4253405, 4251084, 4248811,
+	4246587, 4244409, 4242280, 4240198, 4238163, 4236176, 4234236, 4232343,
+	4230496, 4228697, 4226945, 4225239, 4223580, 4221967, 4220401, 4218881,
+	4217407, 4215980, 4214598, 4213263, 4211974, 4210730, 4209532, 4208380,
+	4207274, 4206213, 4205198, 4204228, 4203304, 4202425, 4201591, 4200803,
+	4200060, 4199362, 4198710, 4198102, 4197540, 4197023, 4196551, 4196124,
+	4195742, 4195405, 4195113, 4194866, 4194663, 4194506, 4194394, 4194326,
+};
+
+const int FISHBOWL_TABLE[320] = {
+	3632374, 3639217, 3646022, 3652787, 3659513, 3666201, 3672848, 3679457,
+	3686026, 3692556, 3699046, 3705496, 3711907, 3718278, 3724609, 3730901,
+	3737152, 3743364, 3749535, 3755666, 3761757, 3767808, 3773818, 3779788,
+	3785717, 3791606, 3797454, 3803262, 3809029, 3814755, 3820440, 3826084,
+	3831687, 3837250, 3842771, 3848251, 3853690, 3859087, 3864443, 3869758,
+	3875032, 3880264, 3885454, 3890603, 3895710, 3900775, 3905799, 3910780,
+	3915720, 3920618, 3925474, 3930288, 3935060, 3939789, 3944477, 3949122,
+	3953725, 3958286, 3962804, 3967280, 3971713, 3976104, 3980452, 3984757,
+	3989020, 3993240, 3997418, 4001552, 4005644, 4009693, 4013699, 4017662,
+	4021581, 4025458, 4029292, 4033082, 4036830, 4040534, 4044195, 4047812,
+	4051387, 4054917, 4058405, 4061849, 4065249, 4068606, 4071919, 4075189,
+	4078415, 4081597, 4084736, 4087831, 4090882, 4093890, 4096853, 4099773,
+	4102648, 4105480, 4108268, 4111012, 4113712, 4116367, 4118979, 4121547,
+	4124070, 4126549, 4128984, 4131375, 4133722, 4136024, 4138282, 4140496,
+	4142665, 4144790, 4146871, 4148907, 4150899, 4152846, 4154749, 4156607,
+	4158421, 4160190, 4161915, 4163595, 4165231, 4166822, 4168368, 4169870,
+	4171327, 4172740, 4174107, 4175430, 4176709, 4177942, 4179131, 4180275,
+	4181374, 4182429, 4183439, 4184404, 4185324, 4186199, 4187029, 4187815,
+	4188556, 4189252, 4189903, 4190509, 4191070, 4191587, 4192058, 4192485,
+	4192867, 4193204, 4193496, 4193743, 4193945, 4194102, 4194214, 4194282,
+	4194304, 4194282, 4194214, 4194102, 4193945, 4193743, 4193496, 4193204,
+	4192867, 4192485, 4192058, 4191587, 4191070, 4190509, 4189903, 4189252,
+	4188556, 4187815, 4187029, 4186199, 4185324, 4184404, 4183439, 4182429,
+	4181374, 4180275, 4179131, 4177942, 4176709, 4175430, 4174107, 4172740,
+	4171327, 4169870, 4168368, 4166822, 4165231, 4163595, 4161915, 4160190,
+	4158421, 4156607, 4154749, 4152846, 4150899, 4148907, 4146871, 4144790,
+	4142665, 4140496, 4138282, 4136024, 4133722, 4131375, 4128984, 4126549,
+	4124070, 4121547, 4118979, 4116367, 4113712, 4111012, 4108268, 4105480,
+	4102648, 4099773, 4096853, 4093890, 4090882, 4087831, 4084736, 4081597,
+	4078415, 4075189, 4071919, 4068606, 4065249, 4061849, 4058405, 4054917,
+	4051387, 4047812, 4044195, 4040534, 4036830, 4033082, 4029292, 4025458,
+	4021581, 4017662, 4013699, 4009693, 4005644, 4001552, 3997418, 3993240,
+	3989020, 3984757, 3980452, 3976104, 3971713, 3967280, 3962804, 3958286,
+	3953725, 3949122, 3944477, 3939789, 3935060, 3930288, 3925474, 3920618,
+	3915720, 3910780, 3905799, 3900775, 3895710, 3890603, 3885454, 3880264,
+	3875032, 3869758, 3864443, 3859087, 3853690, 3848251, 3842771, 3837250,
+	3831687, 3826084, 3820440, 3814755, 3809029, 3803262, 3797454, 3791606,
+	3785717, 3779788, 3773818, 3767808, 3761757, 3755666, 3749535, 3743364,
+	3737152, 3730901, 3724609, 3718278, 3711907, 3705496, 3699046, 3692556,
+	3686026, 3679457, 3672848, 3666201, 3659513, 3652787, 3646022, 3639217,
+};
+
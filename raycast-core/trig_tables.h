@@ -0,0 +1,24 @@
+#ifndef TRIG_TABLES_H
+#define TRIG_TABLES_H
+
+#include "raycast.h"
+
+// Table entries have TABLE_SHIFT fractional bits (10.22). Nothing the ray caster reads from them is bigger
+// than about 306 (sec one RAY_ANGLE_INC away from the axes), so the bits are spent on precision instead.
+// Entries too big for 10.22 saturate at INT_MAX.
+// The tables are generated at build time by gen_trig_tables.c into trig_tables.c, which is checked in
+// so the board build doesn't need to run the generator.
+#define TABLE_SHIFT 22
+#define TABLE_ONE (1 << TABLE_SHIFT)
+
+// indexed by binary angle
+extern const int COS_TABLE[ANGLE_UNITS];
+extern const int SEC_TABLE[ANGLE_UNITS];	// 1 / |cos|, the distance travelled per unit of x
+
+// indexed by screen column, cos of the angle between the ray and the player angle (used to reverse the fishbowl effect)
+extern const int FISHBOWL_TABLE[SCREEN_SIZE_X];
+
+#define fixed_cos(a) (COS_TABLE[(a)])
+#define fixed_sin(a) (COS_TABLE[wrap_angle((a) - ANGLE_UNITS / 4)])
+
+#endif // TRIG_TABLES_H
@@ -0,0 +1,83 @@
+#include "floor.h"
+#include "texture.h"
+#include "shade.h"
+#include "palette.h"
+#include "../raycast-core/trig_tables.h"
+#include "../backend/backend.h"
+
+// tan of the angle between each segment boundary's ray and the player angle, 16.16
+int SEGMENT_TAN[FLOOR_SEGMENTS + 1];
+
+void init_floor_casting() {
+	int segment;
+	for (segment = 0; segment <= FLOOR_SEGMENTS; segment++) {
+		SEGMENT_TAN[segment] = lround(tand(angle_to_degrees(segment * FLOOR_SEGMENT - HALF_FOV_UNITS)) * (1 << 16));
+	}
+}
+
+void cast_floor_rows(int player_x, int player_y, int player_angle, int first_column, int last_column, floor_rows* rows) {
+
+	// the ray of a column at angle b from the player angle a, scaled to reach perpendicular distance 1, is
+	// (cos a + tan b sin a, -sin a + tan b cos a) with the y axis flipped. 10.22
+	int cos_a = fixed_cos(player_angle), sin_a = fixed_sin(player_angle);
+	int first_segment = first_column >> FLOOR_SEGMENT_SHIFT;
+	int last_segment = (last_column + FLOOR_SEGMENT - 1) >> FLOOR_SEGMENT_SHIFT;
+	int dir_x[FLOOR_SEGMENTS + 1], dir_y[FLOOR_SEGMENTS + 1];
+	int segment;
+	for (segment = first_segment; segment <= last_segment; segment++) {
+		dir_x[segment] = cos_a + (int)(((long long)SEGMENT_TAN[segment] * sin_a) >> 16);
+		dir_y[segment] = -sin_a + (int)(((long long)SEGMENT_TAN[segment] * cos_a) >> 16);
+	}
+
+	int row;
+	for (row = 0; row < FLOOR_ROWS; row++) {
+		// a wall at distance d is PROJECTION_FACTOR / d pixels tall (d in unit coordinates), and the eye is half
+		// way up it, so the middle of the row, row + 0.5 below the horizon, sees the floor at
+		// d = PROJECTION_FACTOR / (2 * (row + 0.5)). In 16.16 grid cells
+		int distance = (PROJECTION_FACTOR << 17) / (256 * row + 128);
+		rows->level[row] = SHADING_ENABLED ? distance_light_level(distance) : 0;
+
+		// the world positions seen at both ends of each segment
+		unsigned int end_x = ((unsigned int)player_x << 16) + (unsigned int)(((long long)distance * dir_x[first_segment]) >> 16);
+		unsigned int end_y = ((unsigned int)player_y << 16) + (unsigned int)(((long long)distance * dir_y[first_segment]) >> 16);
+		for (segment = first_segment; segment < last_segment; segment++) {
+			unsigned int start_x = end_x, start_y = end_y;
+			end_x = ((unsigned int)player_x << 16) + (unsigned int)(((long long)distance * dir_x[segment + 1]) >> 16);
+			end_y = ((unsigned int)player_y << 16) + (unsigned int)(((long long)distance * dir_y[segment + 1]) >> 16);
+
+			floor_row_segment* row_segment = &rows->segments[segment][row];
+			row_segment->start_x = start_x;
+			row_segment->start_y = start_y;
+			row_segment->step_x = (unsigned int)((int)(end_x - start_x) >> FLOOR_SEGMENT_SHIFT);
+			row_segment->step_y = (unsigned int)((int)(end_y - start_y) >> FLOOR_SEGMENT_SHIFT);
+		}
+	}
+}
+
+void draw_flat_span(short int* pixel, floor_rows* rows, int screen_column, short int texture[TEXTURE_SIZE][TEXTURE_SIZE], int first_row, int row_step, int count) {
+	unsigned int offset = screen_column & (FLOOR_SEGMENT - 1);
+	const floor_row_segment* row_segment = &rows->segments[screen_column >> FLOOR_SEGMENT_SHIFT][first_row];
+
+	int i, row = first_row;
+	for (i = 0; i < count; i++, row += row_step, row_segment += row_step, pixel += FRAME_BUFFER_STRIDE) {
+		// the same position stepping along the row from the start of the segment would reach
+		unsigned int world_x = row_segment->start_x + row_segment->step_x * offset;
+		unsigned int world_y = row_segment->start_y + row_segment->step_y * offset;
+		short int texel = texture[(world_x >> 16) & (TEXTURE_SIZE - 1)][(world_y >> 16) & (TEXTURE_SIZE - 1)];
+
+		int level = rows->level[row];
+		*pixel = (level != 0) ? shade_pixel(level, texel) : texel;
+	}
+}
+
+void draw_flat_span_indexed(short int* pixel, floor_rows* rows, int screen_column, unsigned char texture[TEXTURE_SIZE][TEXTURE_SIZE], int first_row, int row_step, int count) {
+	unsigned int offset = screen_column & (FLOOR_SEGMENT - 1);
+	const floor_row_segment* row_segment = &rows->segments[screen_column >> FLOOR_SEGMENT_SHIFT][first_row];
+
+	int i, row = first_row;
+	for (i = 0; i < count; i++, row += row_step, row_segment += row_step, pixel += FRAME_BUFFER_STRIDE) {
+		unsigned int world_x = row_segment->start_x + row_segment->step_x * offset;
+		unsigned int world_y = row_segment->start_y + row_segment->step_y * offset;
+		*pixel = SHADE_PALETTE[rows->level[row]][texture[(world_x >> 16) & (TEXTURE_SIZE - 1)][(world_y >> 16) & (TEXTURE_SIZE - 1)]];
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef FLOOR_H
+#define FLOOR_H
+
+#include "../raycast-core/raycast.h"
+#include "texture.h"
+
+// Floor and ceiling casting, one screen row at a time. The eye is half way up the walls, so every floor row
+// below the horizon is at one distance, and the ceiling row mirrored above it is at the same distance and
+// lands on the same texture coordinates. The world position under a row is found at FLOOR_SEGMENT columns
+// apart and stepped linearly in between, which follows the ray angles' slightly non-linear spread across the
+// screen to well under a texel.
+// cast_floor_rows works out the positions once per frame, then the compositor draws a column's ceiling and floor
+// spans with draw_flat_span, which only has to step to the column within its segment.
+
+#define FLOOR_SEGMENT_SHIFT 5
+#define FLOOR_SEGMENT (1 << FLOOR_SEGMENT_SHIFT)
+#define FLOOR_SEGMENTS (SCREEN_SIZE_X / FLOOR_SEGMENT)
+// rows below the horizon, each one pairs with the ceiling row mirrored above the horizon
+#define FLOOR_ROWS (SCREEN_SIZE_Y / 2)
+
+// The world position under a floor row at the start of a segment, and the step from one column to the next,
+// 16.16 unit coordinates. They're unsigned so they can wrap around, only the position within a cell (the
+// low 22 bits) is used
+typedef struct floor_row_segment {
+	unsigned int start_x;
+	unsigned int start_y;
+	unsigned int step_x;
+	unsigned int step_y;
+} floor_row_segment;
+
+typedef struct floor_rows {
+	// indexed [segment][row] so a column reads its rows in order
+	floor_row_segment segments[FLOOR_SEGMENTS][FLOOR_ROWS];
+	// the light level of each row
+	unsigned char level[FLOOR_ROWS];
+} floor_rows;
+
+// works out the ray directions at the segment boundaries
+void init_floor_casting();
+
+// fills in rows for the segments covering screen columns first_column to last_column - 1
+void cast_floor_rows(int player_x, int player_y, int player_angle, int first_column, int last_column, floor_rows* rows);
+
+// draws count pixels of a floor or ceiling span of screen_column with texture, from pixel down the frame buffer.
+// The first pixel is floor row first_row, and each pixel after it is row_step rows further (1 for the floor,
+// -1 for the ceiling, whose rows run towards the horizon going down the screen)
+void draw_flat_span(short int* pixel, floor_rows* rows, int screen_column, short int texture[TEXTURE_SIZE][TEXTURE_SIZE], int first_row, int row_step, int count);
+
+// draw_flat_span with an indexed texture, whose texels are looked up in SHADE_PALETTE (see palette.h)
+void draw_flat_span_indexed(short int* pixel, floor_rows* rows, int screen_column, unsigned char texture[TEXTURE_SIZE][TEXTURE_SIZE], int first_row, int row_step, int count);
+
+#endif // FLOOR_H
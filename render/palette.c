@@ -0,0 +1,267 @@
+#include <stdlib.h>
+
+#include "palette.h"
+#include "texture.h"
+#include "shade.h"
+#include "sprite.h"
+
+#ifdef PALETTE_8BIT
+bool PALETTE_ENABLED = true;
+#else
+bool PALETTE_ENABLED = false;
+#endif
+
+unsigned short PALETTE[PALETTE_SIZE];
+int PALETTE_TEXEL_COLORS = 0;
+unsigned short SHADE_PALETTE[LIGHT_LEVELS][PALETTE_SIZE];
+
+unsigned char WALL_TEXTURES_INDEXED[MAX_WALL_TEXTURES][TEXTURE_SIZE][TEXTURE_SIZE];
+unsigned char WALL_TEXTURE_MIPS_INDEXED[MAX_WALL_TEXTURES][TEXTURE_MIP_TEXELS + TEXTURE_MIP_PADDING];
+unsigned char FLOOR_TEXTURE_INDEXED[TEXTURE_SIZE][TEXTURE_SIZE];
+unsigned char CEILING_TEXTURE_INDEXED[TEXTURE_SIZE][TEXTURE_SIZE];
+unsigned char SPRITE_TEXTURES_INDEXED[SPRITE_TEXTURE_COUNT][TEXTURE_SIZE][TEXTURE_SIZE];
+
+// every texture, most of them MAX_WALL_TEXTURES walls, the floor, the ceiling and the sprites
+#define MAX_TEXTURES (MAX_WALL_TEXTURES + 2 + SPRITE_TEXTURE_COUNT)
+#define MAX_TEXELS (MAX_TEXTURES * TEXTURE_SIZE * TEXTURE_SIZE)
+
+// a colour and how many texels have it
+typedef struct weighted_color {
+	unsigned short color;
+	unsigned int weight;
+} weighted_color;
+
+// the colours of a median cut box, colours[first] to colours[last - 1]
+typedef struct color_box {
+	int first;
+	int last;
+} color_box;
+
+// the textures init_palette indexes, and their indexed copies
+typedef struct palette_texture {
+	short int* texels;
+	unsigned char* indices;
+} palette_texture;
+
+int list_textures(palette_texture* textures);
+int distinct_colors(weighted_color* colors, int count);
+int find_color(const weighted_color* colors, int count, unsigned short color);
+int median_cut(weighted_color* colors, int count, unsigned short* palette, int max_colors);
+int longest_channel(const weighted_color* colors, color_box* box, int* range);
+int compare_colors(const void* a, const void* b);
+int compare_red(const void* a, const void* b);
+int compare_green(const void* a, const void* b);
+int compare_blue(const void* a, const void* b);
+
+// the channels of an RGB565 colour scaled to 0 - 255
+#define red_of(color) (((color) >> 11) << 3)
+#define green_of(color) ((((color) >> 5) & 0x3F) << 2)
+#define blue_of(color) (((color) & 0x1F) << 3)
+
+void init_palette() {
+	static palette_texture textures[MAX_TEXTURES];
+	static weighted_color texels[MAX_TEXELS];
+	int texture_count = list_textures(textures);
+
+	// every colour the textures use, weighted by how many texels have it
+	int count = 0, i, j, level;
+	for (i = 0; i < texture_count; i++) {
+		for (j = 0; j < TEXTURE_SIZE * TEXTURE_SIZE; j++) {
+			if (textures[i].texels[j] == SPRITE_TRANSPARENT) continue;
+			texels[count].color = (unsigned short)textures[i].texels[j];
+			texels[count++].weight = 1;
+		}
+	}
+	int texel_colors = distinct_colors(texels, count);
+
+	if (texel_colors <= PALETTE_COLORS) {
+		// each texel colour keeps its own entry
+		for (i = 0; i < texel_colors; i++) PALETTE[i] = texels[i].color;
+		PALETTE_TEXEL_COLORS = texel_colors;
+	} else {
+		PALETTE_TEXEL_COLORS = median_cut(texels, texel_colors, PALETTE, PALETTE_COLORS);
+		qsort(texels, texel_colors, sizeof(weighted_color), compare_colors);
+	}
+	for (i = PALETTE_TEXEL_COLORS; i < PALETTE_SIZE; i++) PALETTE[i] = (unsigned short)SPRITE_TRANSPARENT;
+
+	// shading the entries with the shade tables gives the same colours shading the RGB565 texels does
+	for (level = 0; level < LIGHT_LEVELS; level++) {
+		for (i = 0; i < PALETTE_SIZE; i++) {
+			SHADE_PALETTE[level][i] = (level == 0) ? PALETTE[i] : shade_pixel(level, PALETTE[i]);
+		}
+	}
+
+	// texels is sorted by colour, so each distinct colour's nearest index is worked out once
+	static unsigned char texel_index[MAX_TEXELS];
+	for (i = 0; i < texel_colors; i++) {
+		texel_index[i] = (texel_colors <= PALETTE_COLORS) ? i : palette_index(texels[i].color);
+	}
+	for (i = 0; i < texture_count; i++) {
+		for (j = 0; j < TEXTURE_SIZE * TEXTURE_SIZE; j++) {
+			short int texel = textures[i].texels[j];
+			textures[i].indices[j] = (texel == SPRITE_TRANSPARENT) ? PALETTE_TRANSPARENT :
+				texel_index[find_color(texels, texel_colors, (unsigned short)texel)];
+		}
+	}
+	for (i = 0; i < WALL_TEXTURE_COUNT; i++) {
+		for (j = 0; j < TEXTURE_MIP_TEXELS; j++) WALL_TEXTURE_MIPS_INDEXED[i][j] = palette_index(WALL_TEXTURE_MIPS[i][j]);
+	}
+}
+
+// fills in textures with every texture loaded and its indexed copy, and returns how many there are
+int list_textures(palette_texture* textures) {
+	int count = 0, i;
+	for (i = 0; i < WALL_TEXTURE_COUNT; i++) {
+		textures[count].texels = &WALL_TEXTURES[i][0][0];
+		textures[count++].indices = &WALL_TEXTURES_INDEXED[i][0][0];
+	}
+	textures[count].texels = &FLOOR_TEXTURE[0][0];
+	textures[count++].indices = &FLOOR_TEXTURE_INDEXED[0][0];
+	textures[count].texels = &CEILING_TEXTURE[0][0];
+	textures[count++].indices = &CEILING_TEXTURE_INDEXED[0][0];
+	for (i = 0; i < SPRITE_TEXTURE_COUNT; i++) {
+		textures[count].texels = &SPRITE_TEXTURES[i][0][0];
+		textures[count++].indices = &SPRITE_TEXTURES_INDEXED[i][0][0];
+	}
+	return count;
+}
+
+int palette_index(short int color) {
+	int colors = PALETTE_TEXEL_COLORS;
+	int red = red_of((unsigned short)color), green = green_of((unsigned short)color), blue = blue_of(color);
+	int best = 0, best_distance = 0x7FFFFFFF, i;
+	for (i = 0; i < colors; i++) {
+		int dr = red_of(PALETTE[i]) - red, dg = green_of(PALETTE[i]) - green, db = blue_of(PALETTE[i]) - blue;
+		int distance = dr * dr + dg * dg + db * db;
+		if (distance < best_distance) {
+			best = i;
+			best_distance = distance;
+		}
+	}
+	return best;
+}
+
+// sorts colors by colour and merges the repeats, adding up their weights. Returns how many are left
+int distinct_colors(weighted_color* colors, int count) {
+	qsort(colors, count, sizeof(weighted_color), compare_colors);
+	int distinct = 0, i;
+	for (i = 0; i < count; i++) {
+		if (distinct > 0 && colors[distinct - 1].color == colors[i].color) {
+			colors[distinct - 1].weight += colors[i].weight;
+		} else {
+			colors[distinct++] = colors[i];
+		}
+	}
+	return distinct;
+}
+
+// the position of color in colors, sorted by distinct_colors, or -1 if it isn't there
+int find_color(const weighted_color* colors, int count, unsigned short color) {
+	int low = 0, high = count - 1;
+	while (low <= high) {
+		int middle = (low + high) / 2;
+		if (colors[middle].color == color) return middle;
+		if (colors[middle].color < color) low = middle + 1;
+		else high = middle - 1;
+	}
+	return -1;
+}
+
+// splits colors into at most max_colors boxes, each time splitting the box with the longest channel range at the
+// weighted median of that channel, and writes the weighted average colour of each box to palette.
+// Returns the number of boxes
+int median_cut(weighted_color* colors, int count, unsigned short* palette, int max_colors) {
+	static color_box boxes[PALETTE_SIZE];
+	static int (*const compare_channel[3])(const void*, const void*) = { compare_red, compare_green, compare_blue };
+	if (count == 0 || max_colors == 0) {
+		return 0;
+	}
+	int box_count = 1, i;
+	boxes[0].first = 0;
+	boxes[0].last = count;
+
+	while (box_count < max_colors) {
+		int split = -1, split_channel = 0, longest = 0;
+		for (i = 0; i < box_count; i++) {
+			if (boxes[i].last - boxes[i].first < 2) continue;
+			int range, channel = longest_channel(colors, &boxes[i], &range);
+			if (range > longest) {
+				split = i;
+				split_channel = channel;
+				longest = range;
+			}
+		}
+		if (split < 0) {
+			break;
+		}
+
+		color_box* box = &boxes[split];
+		qsort(colors + box->first, box->last - box->first, sizeof(weighted_color), compare_channel[split_channel]);
+		unsigned long long total = 0, below = 0;
+		for (i = box->first; i < box->last; i++) total += colors[i].weight;
+		int middle = box->first + 1;
+		for (i = box->first; i < box->last - 1; i++) {
+			below += colors[i].weight;
+			middle = i + 1;
+			if (2 * below >= total) break;
+		}
+		boxes[box_count].first = middle;
+		boxes[box_count++].last = box->last;
+		box->last = middle;
+	}
+
+	for (i = 0; i < box_count; i++) {
+		unsigned long long red = 0, green = 0, blue = 0, weight = 0;
+		int j;
+		for (j = boxes[i].first; j < boxes[i].last; j++) {
+			red += (unsigned long long)(colors[j].color >> 11) * colors[j].weight;
+			green += (unsigned long long)((colors[j].color >> 5) & 0x3F) * colors[j].weight;
+			blue += (unsigned long long)(colors[j].color & 0x1F) * colors[j].weight;
+			weight += colors[j].weight;
+		}
+		palette[i] = ((red + weight / 2) / weight) << 11 | ((green + weight / 2) / weight) << 5 | ((blue + weight / 2) / weight);
+	}
+	return box_count;
+}
+
+// the channel (0 red, 1 green, 2 blue) whose values spread furthest in box, and how far in range
+int longest_channel(const weighted_color* colors, color_box* box, int* range) {
+	int low[3] = { 255, 255, 255 }, high[3] = { 0, 0, 0 }, i, channel;
+	for (i = box->first; i < box->last; i++) {
+		int values[3] = { red_of(colors[i].color), green_of(colors[i].color), blue_of(colors[i].color) };
+		for (channel = 0; channel < 3; channel++) {
+			if (values[channel] < low[channel]) low[channel] = values[channel];
+			if (values[channel] > high[channel]) high[channel] = values[channel];
+		}
+	}
+	int longest = 0;
+	for (channel = 1; channel < 3; channel++) {
+		if (high[channel] - low[channel] > high[longest] - low[longest]) longest = channel;
+	}
+	*range = high[longest] - low[longest];
+	return longest;
+}
+
+int compare_colors(const void* a, const void* b) {
+	return (int)((const weighted_color*)a)->color - (int)((const weighted_color*)b)->color;
+}
+
+int compare_red(const void* a, const void* b) {
+	return red_of(((const weighted_color*)a)->color) - red_of(((const weighted_color*)b)->color);
+}
+
+int compare_green(const void* a, const void* b) {
+	return green_of(((const weighted_color*)a)->color) - green_of(((const weighted_color*)b)->color);
+}
+
+int compare_blue(const void* a, const void* b) {
+	return blue_of(((const weighted_color*)a)->color) - blue_of(((const weighted_color*)b)->color);
+}
+
+void gather_index_column(short int* dst, int dst_stride, const unsigned char* texels, int texel_v, int texel_step, int count, const unsigned short* colors) {
+	int y;
+	for (y = 0; y < count; y++, dst += dst_stride) {
+		*dst = colors[texels[texel_v >> 16]];
+		texel_v += texel_step;
+	}
+}
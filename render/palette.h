@@ -0,0 +1,57 @@
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include <stdbool.h>
+
+#include "texture.h"
+#include "shade.h"
+#include "sprite.h"
+
+// 8 bit indexed textures. When PALETTE_ENABLED is true, draw_frame draws walls, floor, ceiling and sprites from
+// copies of the textures with each texel a one byte index into PALETTE (the _INDEXED arrays), half the bytes of
+// the RGB565 texels, and writes each pixel's RGB565 colour straight into the frame buffer through SHADE_PALETTE,
+// a table of every index's colour at every light level. There is no indexed frame and no pass expanding it: the
+// video core of the board only scans out 16 bit pixels, so the frame buffer is written in RGB565 either way.
+// init_palette builds the palette from the texels of every texture: while there are at most PALETTE_COLORS of them
+// each one keeps its exact colour, and SHADE_PALETTE shades them with shade_pixel, so frames are exactly the RGB565
+// ones, shaded or not. Otherwise the palette is a median cut of the texels. The texels of the wall mip levels (see
+// texture.h) are averages, they take the nearest colour in the palette.
+
+#define PALETTE_SIZE 256
+// the entries that are colours, the last one is PALETTE_TRANSPARENT
+#define PALETTE_COLORS (PALETTE_SIZE - 1)
+// what SPRITE_TRANSPARENT texels become in SPRITE_TEXTURES_INDEXED
+#define PALETTE_TRANSPARENT (PALETTE_SIZE - 1)
+
+// draw_frame draws from the indexed textures when this is true. true when built with PALETTE_8BIT (make PALETTE=1),
+// false otherwise
+extern bool PALETTE_ENABLED;
+
+// the RGB565 colour of each index
+extern unsigned short PALETTE[PALETTE_SIZE];
+
+// the entries init_palette filled in
+extern int PALETTE_TEXEL_COLORS;
+
+// [level][index], the RGB565 colour of index shaded to level (see shade.h). Level 0 is PALETTE
+extern unsigned short SHADE_PALETTE[LIGHT_LEVELS][PALETTE_SIZE];
+
+// the textures with each texel replaced by its index, laid out like the RGB565 ones
+extern unsigned char WALL_TEXTURES_INDEXED[MAX_WALL_TEXTURES][TEXTURE_SIZE][TEXTURE_SIZE];
+extern unsigned char WALL_TEXTURE_MIPS_INDEXED[MAX_WALL_TEXTURES][TEXTURE_MIP_TEXELS + TEXTURE_MIP_PADDING];
+extern unsigned char FLOOR_TEXTURE_INDEXED[TEXTURE_SIZE][TEXTURE_SIZE];
+extern unsigned char CEILING_TEXTURE_INDEXED[TEXTURE_SIZE][TEXTURE_SIZE];
+extern unsigned char SPRITE_TEXTURES_INDEXED[SPRITE_TEXTURE_COUNT][TEXTURE_SIZE][TEXTURE_SIZE];
+
+// builds the palette, SHADE_PALETTE and the indexed textures from the textures loaded. Call again after loading
+// more textures
+void init_palette();
+
+// the index of the palette colour nearest color
+int palette_index(short int color);
+
+// draws count pixels down a column from dst, dst_stride apart, like gather_texel_column (see raster.h) but with
+// indexed texels. colors is the SHADE_PALETTE row of the light level
+void gather_index_column(short int* dst, int dst_stride, const unsigned char* texels, int texel_v, int texel_step, int count, const unsigned short* colors);
+
+#endif // PALETTE_H
@@ -0,0 +1,198 @@
+#include "raster.h"
+#include "shade.h"
+
+#if defined(RASTER_NEON)
+#include <arm_neon.h>
+#elif defined(RASTER_AVX2)
+#include <immintrin.h>
+#elif defined(RASTER_SSE2)
+#include <emmintrin.h>
+#endif
+
+// ---- scalar reference versions ----
+
+void fill_span_scalar(short int* dst, short int color, int count) {
+	int i;
+	for (i = 0; i < count; i++) dst[i] = color;
+}
+
+void blit_row_scalar(short int* dst, const short int* src, int count) {
+	int i;
+	for (i = 0; i < count; i++) dst[i] = src[i];
+}
+
+void blit_texture_scalar(short int* dst, int dst_stride, short int texture[TEXTURE_SIZE][TEXTURE_SIZE]) {
+	int u, v;
+	for (v = 0; v < TEXTURE_SIZE; v++, dst += dst_stride) {
+		for (u = 0; u < TEXTURE_SIZE; u++) dst[u] = texture[u][v];
+	}
+}
+
+// ---- SIMD versions ----
+
+#if defined(RASTER_NEON)
+
+void fill_span(short int* dst, short int color, int count) {
+	uint16x8_t colors = vdupq_n_u16((unsigned short)color);
+	int i;
+	for (i = 0; i + 8 <= count; i += 8) vst1q_u16((uint16_t*)dst + i, colors);
+	for (; i < count; i++) dst[i] = color;
+}
+
+void blit_row(short int* dst, const short int* src, int count) {
+	int i;
+	for (i = 0; i + 8 <= count; i += 8) vst1q_u16((uint16_t*)dst + i, vld1q_u16((const uint16_t*)src + i));
+	for (; i < count; i++) dst[i] = src[i];
+}
+
+// transposes an 8 x 8 block: the 8 texel columns from u, rows v to v + 7, become 8 screen rows
+static void blit_block(short int* dst, int dst_stride, short int texture[TEXTURE_SIZE][TEXTURE_SIZE], int u, int v) {
+	uint16x8_t columns[8];
+	int i;
+	for (i = 0; i < 8; i++) columns[i] = vld1q_u16((const uint16_t*)&texture[u + i][v]);
+
+	uint16x8x2_t pairs[4];
+	for (i = 0; i < 4; i++) pairs[i] = vtrnq_u16(columns[2 * i], columns[2 * i + 1]);
+
+	uint32x4x2_t quads[4];
+	quads[0] = vtrnq_u32(vreinterpretq_u32_u16(pairs[0].val[0]), vreinterpretq_u32_u16(pairs[1].val[0]));
+	quads[1] = vtrnq_u32(vreinterpretq_u32_u16(pairs[0].val[1]), vreinterpretq_u32_u16(pairs[1].val[1]));
+	quads[2] = vtrnq_u32(vreinterpretq_u32_u16(pairs[2].val[0]), vreinterpretq_u32_u16(pairs[3].val[0]));
+	quads[3] = vtrnq_u32(vreinterpretq_u32_u16(pairs[2].val[1]), vreinterpretq_u32_u16(pairs[3].val[1]));
+
+	// screen rows i and i + 4 are the low and high halves of quads (i & 1) for columns 0 - 3 and (i & 1) + 2 for columns 4 - 7
+	for (i = 0; i < 4; i++) {
+		uint32x4_t top = quads[i & 1].val[i >> 1], bottom = quads[2 + (i & 1)].val[i >> 1];
+		uint16_t* row = (uint16_t*)dst + (v + i) * dst_stride + u;
+		vst1q_u16(row, vreinterpretq_u16_u32(vcombine_u32(vget_low_u32(top), vget_low_u32(bottom))));
+		vst1q_u16(row + 4 * dst_stride, vreinterpretq_u16_u32(vcombine_u32(vget_high_u32(top), vget_high_u32(bottom))));
+	}
+}
+
+#elif defined(RASTER_SSE2)
+
+#ifdef RASTER_AVX2
+
+void fill_span(short int* dst, short int color, int count) {
+	__m256i colors = _mm256_set1_epi16(color);
+	int i;
+	for (i = 0; i + 16 <= count; i += 16) _mm256_storeu_si256((__m256i*)(dst + i), colors);
+	if (i + 8 <= count) {
+		_mm_storeu_si128((__m128i*)(dst + i), _mm256_castsi256_si128(colors));
+		i += 8;
+	}
+	for (; i < count; i++) dst[i] = color;
+}
+
+void blit_row(short int* dst, const short int* src, int count) {
+	int i;
+	for (i = 0; i + 16 <= count; i += 16) {
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_loadu_si256((const __m256i*)(src + i)));
+	}
+	if (i + 8 <= count) {
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_loadu_si128((const __m128i*)(src + i)));
+		i += 8;
+	}
+	for (; i < count; i++) dst[i] = src[i];
+}
+
+#else
+
+void fill_span(short int* dst, short int color, int count) {
+	__m128i colors = _mm_set1_epi16(color);
+	int i;
+	for (i = 0; i + 8 <= count; i += 8) _mm_storeu_si128((__m128i*)(dst + i), colors);
+	for (; i < count; i++) dst[i] = color;
+}
+
+void blit_row(short int* dst, const short int* src, int count) {
+	int i;
+	for (i = 0; i + 8 <= count; i += 8) {
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_loadu_si128((const __m128i*)(src + i)));
+	}
+	for (; i < count; i++) dst[i] = src[i];
+}
+
+#endif // RASTER_AVX2
+
+// transposes an 8 x 8 block: the 8 texel columns from u, rows v to v + 7, become 8 screen rows.
+// AVX2 has no faster way to do this than two 128 bit halves, so both builds use this one
+static void blit_block(short int* dst, int dst_stride, short int texture[TEXTURE_SIZE][TEXTURE_SIZE], int u, int v) {
+	__m128i columns[8], pairs[8], quads[8];
+	int i;
+	for (i = 0; i < 8; i++) columns[i] = _mm_loadu_si128((const __m128i*)&texture[u + i][v]);
+
+	// pairs[2i] holds rows 0 - 3 of columns 2i and 2i + 1 interleaved, pairs[2i + 1] rows 4 - 7
+	for (i = 0; i < 4; i++) {
+		pairs[2 * i] = _mm_unpacklo_epi16(columns[2 * i], columns[2 * i + 1]);
+		pairs[2 * i + 1] = _mm_unpackhi_epi16(columns[2 * i], columns[2 * i + 1]);
+	}
+	// quads[0 - 3] hold rows 0 - 1, 2 - 3, 4 - 5 and 6 - 7 of columns 0 - 3, quads[4 - 7] the same for columns 4 - 7
+	for (i = 0; i < 2; i++) {
+		quads[4 * i] = _mm_unpacklo_epi32(pairs[4 * i], pairs[4 * i + 2]);
+		quads[4 * i + 1] = _mm_unpackhi_epi32(pairs[4 * i], pairs[4 * i + 2]);
+		quads[4 * i + 2] = _mm_unpacklo_epi32(pairs[4 * i + 1], pairs[4 * i + 3]);
+		quads[4 * i + 3] = _mm_unpackhi_epi32(pairs[4 * i + 1], pairs[4 * i + 3]);
+	}
+
+	short int* row = dst + v * dst_stride + u;
+	for (i = 0; i < 4; i++, row += 2 * dst_stride) {
+		_mm_storeu_si128((__m128i*)row, _mm_unpacklo_epi64(quads[i], quads[4 + i]));
+		_mm_storeu_si128((__m128i*)(row + dst_stride), _mm_unpackhi_epi64(quads[i], quads[4 + i]));
+	}
+}
+
+#endif
+
+#if defined(RASTER_NEON) || defined(RASTER_SSE2)
+
+void blit_texture(short int* dst, int dst_stride, short int texture[TEXTURE_SIZE][TEXTURE_SIZE]) {
+	int u, v;
+	for (v = 0; v < TEXTURE_SIZE; v += 8) {
+		for (u = 0; u < TEXTURE_SIZE; u += 8) blit_block(dst, dst_stride, texture, u, v);
+	}
+}
+
+#else
+
+void fill_span(short int* dst, short int color, int count) {
+	fill_span_scalar(dst, color, count);
+}
+
+void blit_row(short int* dst, const short int* src, int count) {
+	blit_row_scalar(dst, src, count);
+}
+
+void blit_texture(short int* dst, int dst_stride, short int texture[TEXTURE_SIZE][TEXTURE_SIZE]) {
+	blit_texture_scalar(dst, dst_stride, texture);
+}
+
+#endif
+
+// ---- no SIMD version ----
+// a column's stores are FRAME_BUFFER_STRIDE pixels apart, and they cost more than the texel loads and shading a
+// vector version would save: shading with SIMD, or an AVX2 gather of the texels, measured no faster than this
+
+void gather_texel_column(short int* dst, int dst_stride, const short int* texels, int texel_v, int texel_step, int count, int level) {
+	// columns taller than the texture shade its texels once up front, shorter ones shade just the texels they draw
+	short int shaded_texels[TEXTURE_SIZE];
+	if (level != 0 && count > TEXTURE_SIZE) {
+		int v;
+		for (v = 0; v < TEXTURE_SIZE; v++) shaded_texels[v] = shade_pixel(level, texels[v]);
+		texels = shaded_texels;
+		level = 0;
+	}
+
+	int y;
+	if (level == 0) {
+		for (y = 0; y < count; y++, dst += dst_stride) {
+			*dst = texels[texel_v >> 16];
+			texel_v += texel_step;
+		}
+	} else {
+		for (y = 0; y < count; y++, dst += dst_stride) {
+			*dst = shade_pixel(level, texels[texel_v >> 16]);
+			texel_v += texel_step;
+		}
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include "texture.h"
+
+// Raster kernels for the drawing loops that touch the most pixels. Every kernel but gather_texel_column has a
+// portable scalar version, named with _scalar, which is the reference. The plain name is the fastest version the
+// compiler is allowed to use: NEON on the board (compile with -mfpu=neon), AVX2 or SSE2 on an x86 host, and the
+// scalar version anywhere else, or everywhere when RASTER_SCALAR is defined. All versions draw exactly the same pixels,
+// bench --raster checks each one against its scalar version and times them both.
+// Pixels are RGB565, and dst_stride is in pixels.
+
+#if defined(RASTER_SCALAR)
+#define RASTER_KERNELS "scalar"
+#elif defined(__ARM_NEON)
+#define RASTER_NEON
+#define RASTER_KERNELS "neon"
+#elif defined(__AVX2__)
+#define RASTER_AVX2
+#define RASTER_SSE2
+#define RASTER_KERNELS "avx2"
+#elif defined(__SSE2__)
+#define RASTER_SSE2
+#define RASTER_KERNELS "sse2"
+#else
+#define RASTER_KERNELS "scalar"
+#endif
+
+// fills count pixels from dst with color
+void fill_span(short int* dst, short int color, int count);
+void fill_span_scalar(short int* dst, short int color, int count);
+
+// copies count pixels from src to dst
+void blit_row(short int* dst, const short int* src, int count);
+void blit_row_scalar(short int* dst, const short int* src, int count);
+
+// draws count pixels down a column from dst, dst_stride apart, with texels from a TEXTURE_SIZE texel column.
+// The texel of each pixel is texel_v >> 16, and texel_v steps by texel_step (16.16) every pixel.
+// The texels are shaded to light level (see shade.h), 0 draws them as they are.
+// This is the one kernel with only a scalar version (see raster.c)
+void gather_texel_column(short int* dst, int dst_stride, const short int* texels, int texel_v, int texel_step, int count, int level);
+
+// draws a column major texture ([u][v], see texture.h) TEXTURE_SIZE x TEXTURE_SIZE pixels, with its top left at dst
+void blit_texture(short int* dst, int dst_stride, short int texture[TEXTURE_SIZE][TEXTURE_SIZE]);
+void blit_texture_scalar(short int* dst, int dst_stride, short int texture[TEXTURE_SIZE][TEXTURE_SIZE]);
+
+#endif // RASTER_H
@@ -0,0 +1,516 @@
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "render.h"
+#include "texture.h"
+#include "shade.h"
+#include "floor.h"
+#include "raster.h"
+#include "palette.h"
+#include "sprite.h"
+#include "resolution.h"
+#include "../raycast-core/raycast.h"
+#include "../raycast-core/ray_cache.h"
+#include "../backend/backend.h"
+#include "../raycast-core/map_grid.h"
+#include "../Map_Data.h"
+#include "../profile/profile.h"
+
+// the slices cast for the frame being drawn
+frame_slices FRAME_SLICES;
+
+// each worker counts the pixels of its own columns
+int COLUMN_PIXEL_WRITES[SCREEN_SIZE_X];
+
+// the rays hit in earlier frames, reused while the player stands still
+ray_cache RAY_CACHE;
+bool RAY_REUSE_ENABLED = true;
+int FRAME_RAYS_CAST = 0;
+
+// what went into each frame buffer, so the columns that come out the same can be skipped
+frame_history FRAME_HISTORY;
+bool COLUMN_SKIPPING_ENABLED = true;
+int FRAME_COLUMNS_SKIPPED = 0;
+int FRAME_WALLS_SKIPPED = 0;
+
+render_target SCREEN_TARGET = { NULL, &FRAME_SLICES, COLUMN_PIXEL_WRITES, &SPRITE_FRAME, &RAY_CACHE, &FRAME_HISTORY, NULL, 0, 0, 0 };
+
+// what every worker of draw_frame_parallel needs to know to draw its columns
+typedef struct frame_job {
+	render_target* target;
+	int player_x;
+	int player_y;
+	int player_angle;
+	int worker_count;
+	// RENDER_COLUMN_SHIFT for the whole frame
+	int column_shift;
+	// what the buffer drawn into holds, or NULL if it isn't known, and whether it was drawn from the same view or
+	// at least the same angle. Turning moves every wall across the columns, so walls are only compared without it
+	const drawn_frame* previous;
+	bool same_view;
+	bool same_angle;
+} frame_job;
+
+void worker_columns(frame_job* job, int worker, int* first_column, int* last_column);
+void draw_frame_columns(int worker, void* arg);
+void draw_sprite_job(int worker, void* arg);
+void begin_drawn_frame(frame_job* job);
+bool same_drawn_column(const drawn_column* a, const drawn_column* b);
+void composite_column(frame_job* job, int screen_column, floor_rows* rows);
+void draw_wall_column(render_target* target, int screen_column, int wall_size, int level);
+void widen_slice(frame_slices* slices, int screen_column, int first_column, int last_column);
+void widen_columns(render_target* target, int first_column, int last_column, int block);
+
+// clears the current frame buffer by filling every row with black
+void clear_screen() {
+	int y;
+	for (y = 0; y < SCREEN_SIZE_Y; y++) {
+		fill_span(FRAME_BUFFER_ADDR + y * FRAME_BUFFER_STRIDE, 0x0000, SCREEN_SIZE_X);
+	}
+}
+
+// draws a rect_color rectangle at (x0, y0) from the top-left, with sizes x_size and y_size.
+// draws rectangle by filling y_size rows of x_size pixels
+void draw_rectangle(int x0, int y0, int x_size, int y_size, short int rect_color) {
+	int y;
+	for (y = y0; y < y0 + y_size; y++) {
+		fill_span(FRAME_BUFFER_ADDR + y * FRAME_BUFFER_STRIDE + x0, rect_color, x_size);
+	}
+}
+
+// draws a row major image of width x height pixels at (x0, y0) from the top-left
+void draw_image(int x0, int y0, int width, int height, const short int* pixels) {
+	int y;
+	for (y = 0; y < height; y++) {
+		blit_row(FRAME_BUFFER_ADDR + (y0 + y) * FRAME_BUFFER_STRIDE + x0, pixels + y * width, width);
+	}
+}
+
+// draws a column major texture (see texture.h) at (x0, y0) from the top-left
+void draw_texture(int x0, int y0, short int texture[TEXTURE_SIZE][TEXTURE_SIZE]) {
+	blit_texture(FRAME_BUFFER_ADDR + y0 * FRAME_BUFFER_STRIDE + x0, FRAME_BUFFER_STRIDE, texture);
+}
+
+// draw a line to the frame buffer using Bresenham's algorithm.
+// Bresenham's algorithm increments in x, and makes decisions on whether to increment y
+// based on accumulated error. If the slope is too steep, flip the coordinates to draw a smoother line
+void draw_line(int x0, int y0, int x1, int y1, short int line_color) {
+
+	// horizontal lines are a span fill
+	if (y0 == y1) {
+		int left = (x0 < x1) ? x0 : x1;
+		fill_span(FRAME_BUFFER_ADDR + y0 * FRAME_BUFFER_STRIDE + left, line_color, abs(x1 - x0) + 1);
+		return;
+	}
+
+	// if the slope is too steep, we should flip the coordinates, since this draws a smoother line
+	bool is_steep = abs(y1 - y0) > abs(x1 - x0);
+	// flip the coordinates. later we will draw a flipped line to compensate
+	if (is_steep) {
+		swap(&x0, &y0);
+		swap(&x1, &y1);
+	}
+
+	// if the starting coordinate is greater, swap coords since drawing the line
+	// backwards is the same as drawing it forwards
+	if (x0 > x1) {
+		swap(&x0, &x1);
+		swap(&y0, &y1);
+	}
+
+	int deltaX = x1 - x0;
+	int deltaY = abs(y1 - y0);
+	int accumulated_error = -(deltaX / 2);
+	int y = y0;
+
+	int y_inc;
+	// set the y_increment, 1 if increasing downwards (+ve slope), -1 if increasing upwards (-ve slope)
+	if (y0 < y1) {
+		y_inc = 1;
+	} else {
+		y_inc = -1;
+	}
+
+	// incrementing x to draw the line
+	int x;
+	for (x = x0; x <= x1; x++) {
+		// draw the line flipped since we flipped the coordinates previously
+		if (is_steep) {
+			plot_pixel(y, x, line_color);
+		} else {
+			plot_pixel(x, y, line_color);
+		}
+		// accumulate the error over iterations
+		accumulated_error += deltaY;
+		// if the error overflows, increment y so that it follows the line
+		if (accumulated_error >= 0) {
+			y = y + y_inc;
+			accumulated_error -= deltaX;
+		}
+	}
+}
+
+// swaps two ints in memory
+void swap(int *x, int *y) {
+	int temp = *x;
+	*x = *y;
+	*y = temp;
+}
+
+// plot a pixel at x, y by writing to the frame buffer
+void plot_pixel(int x, int y, short int pixel_color) 
+{
+	FRAME_BUFFER_ADDR[y * FRAME_BUFFER_STRIDE + x] = pixel_color;
+}
+
+void init_render()
+{
+	init_wall_textures();
+	init_floor_textures();
+	init_shade_tables();
+	init_floor_casting();
+	init_sprite_textures();
+	init_palette();
+	ray_cache_init(&RAY_CACHE);
+	forget_drawn_frames();
+}
+
+void forget_drawn_frames()
+{
+	int i;
+	for (i = 0; i < DRAWN_FRAMES; i++) {
+		FRAME_HISTORY.frames[i].buffer = NULL;
+	}
+}
+
+void draw_frame(int player_x, int player_y, int player_angle)
+{
+	draw_frame_parallel(player_x, player_y, player_angle, RENDER_WORKERS);
+}
+
+void draw_frame_parallel(int player_x, int player_y, int player_angle, int worker_count)
+{
+	// every worker traces against the same copy of the map, even if MAP_DATA changes mid frame.
+	// A loaded map file is used as it is
+	if (!MAP_GRID.read_only) {
+		PROFILE_BEGIN(STAGE_SNAPSHOT);
+		snapshot_map();
+		PROFILE_END(STAGE_SNAPSHOT);
+	}
+
+	SCREEN_TARGET.frame_buffer = FRAME_BUFFER_ADDR;
+	SCREEN_TARGET.cache = RAY_REUSE_ENABLED ? &RAY_CACHE : NULL;
+	if (COLUMN_SKIPPING_ENABLED) {
+		SCREEN_TARGET.history = &FRAME_HISTORY;
+	} else {
+		// the frames drawn while it's off aren't kept track of
+		forget_drawn_frames();
+		SCREEN_TARGET.history = NULL;
+	}
+	draw_frame_target(&SCREEN_TARGET, player_x, player_y, player_angle, worker_count);
+	FRAME_RAYS_CAST = SCREEN_TARGET.rays_cast;
+	FRAME_COLUMNS_SKIPPED = SCREEN_TARGET.columns_skipped;
+	FRAME_WALLS_SKIPPED = SCREEN_TARGET.walls_skipped;
+}
+
+void draw_frame_target(render_target* target, int player_x, int player_y, int player_angle, int worker_count)
+{
+	frame_job job;
+	job.target = target;
+	job.player_x = player_x;
+	job.player_y = player_y;
+	job.player_angle = player_angle;
+	// every range of columns needs a worker to draw it
+	job.worker_count = backend_workers(worker_count);
+	job.column_shift = RENDER_COLUMN_SHIFT;
+
+	// before the workers start, as they all share the cache
+	if (target->cache != NULL) {
+		ray_cache_begin_frame(target->cache, player_x, player_y);
+	}
+	target->rays_cast = 0;
+	target->columns_skipped = 0;
+	target->walls_skipped = 0;
+	begin_drawn_frame(&job);
+
+	backend_parallel_for(job.worker_count, draw_frame_columns, &job);
+
+	// the sprites go over the walls, once every column's wall distance is known
+	PROFILE_BEGIN(STAGE_SPRITES);
+	prepare_sprites(player_x, player_y, player_angle, target->slices, target->sprites);
+	if (target->sprites->count > 0) {
+		backend_parallel_for(job.worker_count, draw_sprite_job, &job);
+	}
+	PROFILE_END(STAGE_SPRITES);
+}
+
+void draw_sprite_job(int worker, void* arg)
+{
+	frame_job* job = arg;
+	int first_column, last_column;
+	worker_columns(job, worker, &first_column, &last_column);
+	draw_sprite_columns(job->target, first_column, last_column);
+}
+
+// finds what the buffer the frame is drawn into holds in the target's history, and takes its place in the history
+// over to record the frame being drawn
+void begin_drawn_frame(frame_job* job)
+{
+	render_target* target = job->target;
+	job->previous = NULL;
+	job->same_view = false;
+	job->same_angle = false;
+	target->drawn = NULL;
+	if (target->history == NULL) {
+		return;
+	}
+
+	frame_history* history = target->history;
+	drawn_frame* drawn = NULL;
+	int i;
+	for (i = 0; i < DRAWN_FRAMES; i++) {
+		if (history->frames[i].buffer == target->frame_buffer) {
+			drawn = &history->frames[i];
+		}
+	}
+
+	if (drawn != NULL && drawn->column_shift == job->column_shift && drawn->shading == SHADING_ENABLED && drawn->mipmaps == MIPMAPS_ENABLED &&
+		drawn->palette == PALETTE_ENABLED) {
+		job->previous = drawn;
+		job->same_angle = drawn->player_angle == job->player_angle;
+		job->same_view = job->same_angle && drawn->player_x == job->player_x && drawn->player_y == job->player_y;
+	}
+	if (drawn == NULL) {
+		drawn = &history->frames[history->next];
+		history->next = (history->next + 1) % DRAWN_FRAMES;
+	}
+
+	// each column is compared with what it held before it is written over
+	drawn->buffer = target->frame_buffer;
+	drawn->player_x = job->player_x;
+	drawn->player_y = job->player_y;
+	drawn->player_angle = job->player_angle;
+	drawn->column_shift = job->column_shift;
+	drawn->shading = SHADING_ENABLED;
+	drawn->mipmaps = MIPMAPS_ENABLED;
+	drawn->palette = PALETTE_ENABLED;
+	target->drawn = drawn;
+}
+
+// each worker casts and draws its own contiguous range of screen columns, made of whole blocks of cast columns
+void worker_columns(frame_job* job, int worker, int* first_column, int* last_column)
+{
+	int blocks = SCREEN_SIZE_X >> job->column_shift;
+	*first_column = (worker * blocks / job->worker_count) << job->column_shift;
+	*last_column = ((worker + 1) * blocks / job->worker_count) << job->column_shift;
+}
+
+void draw_frame_columns(int worker, void* arg)
+{
+	frame_job* job = arg;
+	render_target* target = job->target;
+	frame_slices* slices = target->slices;
+	int first_column, last_column;
+	worker_columns(job, worker, &first_column, &last_column);
+	int block = 1 << job->column_shift;
+
+	PROFILE_BEGIN(STAGE_CAST);
+	int rays_cast = 0, i;
+	if (block == 1) {
+		rays_cast = last_column - first_column;
+		if (target->cache != NULL) {
+			rays_cast = cast_frame_columns_cached(target->cache, job->player_x, job->player_y, job->player_angle, first_column, last_column, slices);
+		} else {
+			cast_frame_columns(job->player_x, job->player_y, job->player_angle, first_column, last_column, slices);
+		}
+	} else {
+		// at a lower resolution, cast the column in the middle of each block and use its slice for the whole block
+		for (i = first_column; i < last_column; i += block) {
+			int cast_column = i + block / 2;
+			if (target->cache != NULL) {
+				rays_cast += cast_frame_columns_cached(target->cache, job->player_x, job->player_y, job->player_angle, cast_column, cast_column + 1, slices);
+			} else {
+				cast_frame_columns(job->player_x, job->player_y, job->player_angle, cast_column, cast_column + 1, slices);
+				rays_cast++;
+			}
+			widen_slice(slices, cast_column, i, i + block);
+		}
+	}
+	__atomic_fetch_add(&target->rays_cast, rays_cast, __ATOMIC_RELAXED);
+	PROFILE_END(STAGE_CAST);
+
+	PROFILE_BEGIN(STAGE_FLOOR);
+	floor_rows rows;
+	cast_floor_rows(job->player_x, job->player_y, job->player_angle, first_column, last_column, &rows);
+	PROFILE_END(STAGE_FLOOR);
+
+	// iterate through the columns, drawing each one top to bottom
+	PROFILE_BEGIN(STAGE_COMPOSITE);
+	int columns_skipped = 0, walls_skipped = 0;
+	for (i = first_column; i < last_column; i += block) {
+		int cast_column = i + block / 2;
+		composite_column(job, cast_column, &rows);
+		PROFILE_COUNT(COUNTER_PIXELS, block * target->column_pixel_writes[cast_column]);
+		// a column drawn whole writes every pixel of it once
+		if (target->column_pixel_writes[cast_column] == 0) {
+			columns_skipped += block;
+		} else if (target->column_pixel_writes[cast_column] < SCREEN_SIZE_Y) {
+			walls_skipped += block;
+		}
+	}
+	if (block > 1) {
+		widen_columns(target, first_column, last_column, block);
+	}
+	__atomic_fetch_add(&target->columns_skipped, columns_skipped, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&target->walls_skipped, walls_skipped, __ATOMIC_RELAXED);
+	PROFILE_COUNT(COUNTER_SKIPPED_COLUMNS, columns_skipped);
+	PROFILE_END(STAGE_COMPOSITE);
+}
+
+// copies the slice cast at screen_column to the other columns from first_column to last_column - 1
+void widen_slice(frame_slices* slices, int screen_column, int first_column, int last_column)
+{
+	int i;
+	for (i = first_column; i < last_column; i++) {
+		if (i == screen_column) continue;
+		slices->size[i] = slices->size[screen_column];
+		slices->location[i] = slices->location[screen_column];
+		slices->distance[i] = slices->distance[screen_column];
+		slices->cell_x[i] = slices->cell_x[screen_column];
+		slices->cell_y[i] = slices->cell_y[screen_column];
+		slices->face[i] = slices->face[screen_column];
+		slices->texture_u[i] = slices->texture_u[screen_column];
+		slices->tile_type[i] = slices->tile_type[screen_column];
+		slices->steps[i] = 0;
+	}
+}
+
+// copies the pixels drawn in the middle column of each block of block columns from first_column to last_column
+// to the rest of the block, a row at a time. Blocks whose middle column was skipped already hold them
+void widen_columns(render_target* target, int first_column, int last_column, int block)
+{
+	int y, i, j;
+	short int* row = target->frame_buffer;
+	for (y = 0; y < SCREEN_SIZE_Y; y++, row += FRAME_BUFFER_STRIDE) {
+		for (i = first_column; i < last_column; i += block) {
+			if (target->column_pixel_writes[i + block / 2] == 0) continue;
+			short int pixel = row[i + block / 2];
+			for (j = i; j < i + block; j++) row[j] = pixel;
+		}
+	}
+	for (i = first_column; i < last_column; i += block) {
+		for (j = i; j < i + block; j++) target->column_pixel_writes[j] = target->column_pixel_writes[i + block / 2];
+	}
+}
+
+// true if the same wall slice is drawn from a and b
+bool same_drawn_column(const drawn_column* a, const drawn_column* b)
+{
+	return a->location == b->location && a->size == b->size && a->wall_size == b->wall_size &&
+		a->tile_type == b->tile_type && a->texture_u == b->texture_u && a->level == b->level;
+}
+
+// draws a whole screen column in one pass down the frame buffer: the ceiling above the wall slice, the slice,
+// and the floor below it, so every pixel is written exactly once. Leaves out what the buffer already holds
+void composite_column(frame_job* job, int screen_column, floor_rows* rows)
+{
+	render_target* target = job->target;
+	frame_slices* slices = target->slices;
+	// columns without a wall are all ceiling and floor
+	int ceiling_end = SCREEN_SIZE_Y / 2, floor_start = SCREEN_SIZE_Y / 2;
+	if (slices->size[screen_column] != INT_MAX) {
+		ceiling_end = slices->location[screen_column];
+		floor_start = ceiling_end + slices->size[screen_column];
+	}
+
+	// the wall's size before it is limited to the screen and its light level, for draw_wall_column and the history
+	int wall_size = 0, level = 0;
+	if (floor_start > ceiling_end) {
+		wall_size = projected_slice_size(slices->distance[screen_column]);
+		level = SHADING_ENABLED ? light_level(slices->distance[screen_column], slices->face[screen_column]) : 0;
+	}
+
+	bool same_wall = false;
+	if (target->drawn != NULL) {
+		drawn_column column = { ceiling_end, floor_start - ceiling_end, wall_size, 0, 0, level, false };
+		if (floor_start > ceiling_end) {
+			column.tile_type = slices->tile_type[screen_column];
+			column.texture_u = slices->texture_u[screen_column];
+		}
+		// sprite pixels have to be drawn over again, in any column of the block the column is widened over. previous
+		// can be the frame being drawn, so each column's flag is read before it is cleared
+		int block = 1 << job->column_shift, j;
+		bool sprites = false;
+		for (j = screen_column - block / 2; j < screen_column - block / 2 + block; j++) {
+			if (job->previous != NULL && job->previous->columns[j].sprites) sprites = true;
+			target->drawn->columns[j].sprites = false;
+		}
+		same_wall = job->same_angle && !sprites && same_drawn_column(&job->previous->columns[screen_column], &column);
+		target->drawn->columns[screen_column] = column;
+
+		if (same_wall && job->same_view) {
+			target->column_pixel_writes[screen_column] = 0;
+			return;
+		}
+	}
+
+	// the ceiling starts at the top of the screen, the floor row furthest from the horizon
+	if (PALETTE_ENABLED) {
+		draw_flat_span_indexed(target->frame_buffer + screen_column, rows, screen_column, CEILING_TEXTURE_INDEXED, FLOOR_ROWS - 1, -1, ceiling_end);
+	} else {
+		draw_flat_span(target->frame_buffer + screen_column, rows, screen_column, CEILING_TEXTURE, FLOOR_ROWS - 1, -1, ceiling_end);
+	}
+	int pixel_writes = ceiling_end;
+
+	if (floor_start > ceiling_end && !same_wall) {
+		draw_wall_column(target, screen_column, wall_size, level);
+		pixel_writes += floor_start - ceiling_end;
+	}
+
+	if (PALETTE_ENABLED) {
+		draw_flat_span_indexed(target->frame_buffer + floor_start * FRAME_BUFFER_STRIDE + screen_column, rows, screen_column, FLOOR_TEXTURE_INDEXED,
+			floor_start - SCREEN_SIZE_Y / 2, 1, SCREEN_SIZE_Y - floor_start);
+	} else {
+		draw_flat_span(target->frame_buffer + floor_start * FRAME_BUFFER_STRIDE + screen_column, rows, screen_column, FLOOR_TEXTURE,
+			floor_start - SCREEN_SIZE_Y / 2, 1, SCREEN_SIZE_Y - floor_start);
+	}
+	pixel_writes += SCREEN_SIZE_Y - floor_start;
+
+	target->column_pixel_writes[screen_column] = pixel_writes;
+}
+
+// draws the wall slice of a screen column with its texture. The texture column comes from where the ray hit
+// the wall, and the texture row steps down the slice in 16.16 fixed point, starting part way down the
+// texture when the wall is taller than the screen. Slices shorter than the texture draw from a smaller mip level
+// (see texture.h). The whole column has light level level. wall_size is the slice size before it was limited to
+// the screen
+void draw_wall_column(render_target* target, int screen_column, int wall_size, int level)
+{
+	frame_slices* slices = target->slices;
+	int location = slices->location[screen_column];
+	int size = slices->size[screen_column];
+	short int* pixel = target->frame_buffer + location * FRAME_BUFFER_STRIDE + screen_column;
+
+	if (WALL_TEXTURE_COUNT == 0) {
+		// no textures loaded
+		int y;
+		for (y = 0; y < size; y++, pixel += FRAME_BUFFER_STRIDE) *pixel = 0x003F;
+		return;
+	}
+
+	// where the slice would start if it wasn't limited to the screen
+	int wall_top = (SCREEN_SIZE_Y - wall_size) / 2;
+
+	int mip = wall_mip_level(wall_size);
+	int texel_step = ((TEXTURE_SIZE >> mip) << 16) / wall_size;
+	int texel_v = (location - wall_top) * texel_step;
+
+	int texture = wall_texture_slot(slices->tile_type[screen_column]);
+	int texture_u = slices->texture_u[screen_column];
+	if (PALETTE_ENABLED) {
+		const unsigned char* texels = (mip == 0) ? WALL_TEXTURES_INDEXED[texture][texture_u] : WALL_TEXTURE_MIPS_INDEXED[texture] + mip_column_offset(mip, texture_u);
+		gather_index_column(pixel, FRAME_BUFFER_STRIDE, texels, texel_v, texel_step, size, SHADE_PALETTE[level]);
+	} else {
+		gather_texel_column(pixel, FRAME_BUFFER_STRIDE, wall_texel_column(texture, mip, texture_u), texel_v, texel_step, size, level);
+	}
+}
@@ -0,0 +1,131 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdbool.h>
+
+#include "../raycast-core/raycast.h"
+#include "../raycast-core/ray_cache.h"
+#include "texture.h"
+#include "sprite.h"
+
+// all drawing goes to FRAME_BUFFER_ADDR, provided by the linked backend (see backend/backend.h)
+
+// number of workers draw_frame splits the screen columns between
+#ifndef RENDER_WORKERS
+#define RENDER_WORKERS 1
+#endif
+
+void clear_screen();
+void draw_rectangle(int x0, int y0, int x_size, int y_size, short int rect_color);
+void draw_line(int x0, int y0, int x1, int y1, short int line_color);
+void draw_image(int x0, int y0, int width, int height, const short int* pixels);
+void draw_texture(int x0, int y0, short int texture[TEXTURE_SIZE][TEXTURE_SIZE]);
+void plot_pixel(int x, int y, short int pixel_color);
+void swap(int *x, int *y);
+
+// the slices cast for the last frame
+extern frame_slices FRAME_SLICES;
+
+// the number of pixels draw_frame wrote to each screen column of the last frame
+extern int COLUMN_PIXEL_WRITES[];
+
+// when true (the default), draw_frame only casts the rays it doesn't have from earlier frames, see
+// raycast-core/ray_cache.h. The frames drawn are the same either way
+extern bool RAY_REUSE_ENABLED;
+
+// the number of rays draw_frame cast for the last frame
+extern int FRAME_RAYS_CAST;
+
+// when true (the default), draw_frame skips the columns that would come out the same as what it drew into the same
+// buffer before (see frame_history). The frames drawn are the same either way
+extern bool COLUMN_SKIPPING_ENABLED;
+
+// the columns draw_frame skipped in the last frame, whole and only the wall slice
+extern int FRAME_COLUMNS_SKIPPED;
+extern int FRAME_WALLS_SKIPPED;
+
+// What a column of a frame was drawn from: the wall slice's place on screen, its height before it was limited to
+// the screen, the tile type, texture column and light level (size is 0 when there is no wall), and whether any
+// sprite pixels went over it
+typedef struct drawn_column {
+	short int location;
+	short int size;
+	int wall_size;
+	unsigned char tile_type;
+	unsigned char texture_u;
+	unsigned char level;
+	bool sprites;
+} drawn_column;
+
+// what a frame buffer was last drawn with
+typedef struct drawn_frame {
+	// NULL while it is unused
+	const short int* buffer;
+	int player_x;
+	int player_y;
+	int player_angle;
+	int column_shift;
+	bool shading;
+	bool mipmaps;
+	bool palette;
+	drawn_column columns[SCREEN_SIZE_X];
+} drawn_frame;
+
+// enough for triple buffering
+#define DRAWN_FRAMES 3
+
+// Column dirty tracking. With double buffering the back buffer still holds the frame before last, so a frame
+// history keeps what went into each buffer drawn into, found by its address. A column whose wall slice is the same
+// as the one already in the buffer doesn't have its wall drawn again, and when the player hasn't moved or turned
+// either, its ceiling and floor are the same as well and the whole column is skipped. Columns that had sprites over
+// them are always drawn again. Anything else that writes into a frame buffer has to call forget_drawn_frames
+typedef struct frame_history {
+	drawn_frame frames[DRAWN_FRAMES];
+	// the frame reused next for a buffer that isn't in the history
+	int next;
+} frame_history;
+
+// forgets what was drawn into every frame buffer, so the next frames are drawn whole
+void forget_drawn_frames();
+
+// Everything a frame is drawn into. draw_frame draws into SCREEN_TARGET: the back buffer, FRAME_SLICES,
+// COLUMN_PIXEL_WRITES, SPRITE_FRAME, RAY_CACHE and FRAME_HISTORY.
+// Other targets, such as the workers of the batch renderer (host/batch.h), bring their own and only share the map,
+// textures and sprites, so they can draw at the same time
+typedef struct render_target {
+	// FRAME_BUFFER_STRIDE pixels a row
+	short int* frame_buffer;
+	frame_slices* slices;
+	// SCREEN_SIZE_X counts, the pixels written to each screen column
+	int* column_pixel_writes;
+	sprite_frame* sprites;
+	// the rays kept from earlier frames, or NULL to cast every ray
+	ray_cache* cache;
+	// what was drawn into its buffers before, or NULL to draw every column
+	frame_history* history;
+	// the frame of history that is being drawn, set by draw_frame_target
+	drawn_frame* drawn;
+	// the rays cast for the last frame, and the columns skipped whole and without their walls
+	int rays_cast;
+	int columns_skipped;
+	int walls_skipped;
+} render_target;
+
+extern render_target SCREEN_TARGET;
+
+// loads the textures and builds the shade and floor casting tables. Call once before drawing frames
+void init_render();
+
+// casts a ray for every screen column from the given player position and draws the wall slices, floor and ceiling,
+// then the sprites (see sprite.h), using RENDER_WORKERS workers. player_angle is a binary angle (see raycast.h)
+void draw_frame(int player_x, int player_y, int player_angle);
+
+// same as draw_frame, with the screen split into worker_count ranges of columns that are cast and drawn in
+// parallel (see backend_parallel_for). Each worker only writes its own columns, so the output is the same as draw_frame
+void draw_frame_parallel(int player_x, int player_y, int player_angle, int worker_count);
+
+// draws a frame into target like draw_frame_parallel. Unlike draw_frame it traces MAP_GRID as it is, without
+// taking a snapshot of MAP_DATA first, so call snapshot_map before if MAP_DATA changed
+void draw_frame_target(render_target* target, int player_x, int player_y, int player_angle, int worker_count);
+
+#endif // RENDER_H
@@ -0,0 +1,37 @@
+#include "resolution.h"
+
+int RENDER_COLUMN_SHIFT = 0;
+
+void resolution_init(resolution_controller* controller, unsigned int budget_us) {
+	controller->budget_us = budget_us;
+	controller->average_us = 0;
+	controller->column_shift = 0;
+	controller->frames_since_change = 0;
+}
+
+int resolution_update(resolution_controller* controller, unsigned int frame_us) {
+	if (controller->average_us == 0) {
+		// the first frame starts the average
+		controller->average_us = frame_us;
+	}
+	int difference = (int)frame_us - (int)controller->average_us;
+	controller->average_us += difference / (1 << RESOLUTION_AVERAGE_SHIFT);
+
+	if (controller->frames_since_change < RESOLUTION_HOLD_FRAMES) {
+		controller->frames_since_change++;
+		return controller->column_shift;
+	}
+
+	if (controller->average_us > controller->budget_us && controller->column_shift < MAX_COLUMN_SHIFT) {
+		// about half the rays, until the average catches up
+		controller->column_shift++;
+		controller->average_us /= 2;
+		controller->frames_since_change = 0;
+	} else if (controller->column_shift > 0 &&
+		controller->average_us * 2 < controller->budget_us / 4 * RESOLUTION_RAISE_QUARTERS) {
+		controller->column_shift--;
+		controller->average_us *= 2;
+		controller->frames_since_change = 0;
+	}
+	return controller->column_shift;
+}
@@ -0,0 +1,45 @@
+#ifndef RESOLUTION_H
+#define RESOLUTION_H
+
+// Dynamic resolution. draw_frame casts a ray for every (1 << RENDER_COLUMN_SHIFT)th screen column, through the
+// middle of each block of that many columns, and draws the block as that one column made wider: 320, 160 or 80
+// rays a frame. A resolution_controller picks the shift for the next frame from how long the last frames took
+// against a frame time budget, so views with long rays drop resolution instead of frame rate.
+// The main loop runs it when built with DYNAMIC_RESOLUTION (make DYNAMIC=1), with a budget of FRAME_BUDGET_US.
+
+// the coarsest level, SCREEN_SIZE_X >> MAX_COLUMN_SHIFT columns cast
+#define MAX_COLUMN_SHIFT 2
+
+// the frame time the main loop's controller aims for, by default that of MIN_FRAME_RATE
+#define MIN_FRAME_RATE 30
+#ifndef FRAME_BUDGET_US
+#define FRAME_BUDGET_US (1000000 / MIN_FRAME_RATE)
+#endif
+
+// the average frame time moves 1 / (1 << RESOLUTION_AVERAGE_SHIFT) of the way to each new frame time
+#define RESOLUTION_AVERAGE_SHIFT 3
+// frames the controller waits after changing level before it changes again, so the average can settle
+#define RESOLUTION_HOLD_FRAMES 8
+// a finer level is only picked if twice the average frame time is under this many quarters of the budget
+#define RESOLUTION_RAISE_QUARTERS 3
+
+// screen columns per cast column is 1 << RENDER_COLUMN_SHIFT, 0 (every column, the default) to MAX_COLUMN_SHIFT
+extern int RENDER_COLUMN_SHIFT;
+
+typedef struct resolution_controller {
+	unsigned int budget_us;
+	// the running average of the frame time
+	unsigned int average_us;
+	int column_shift;
+	int frames_since_change;
+} resolution_controller;
+
+// starts a controller at full resolution
+void resolution_init(resolution_controller* controller, unsigned int budget_us);
+
+// adds how long the last frame took, and returns the column shift to draw the next one with. The level drops
+// as soon as the average frame time is over budget, and only rises when doubling the columns would still leave
+// room in the budget
+int resolution_update(resolution_controller* controller, unsigned int frame_us);
+
+#endif // RESOLUTION_H
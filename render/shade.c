@@ -0,0 +1,30 @@
+#include "shade.h"
+#include "../raycast-core/raycast.h"
+
+unsigned short SHADE_RED[LIGHT_LEVELS][32];
+unsigned short SHADE_GREEN[LIGHT_LEVELS][64];
+unsigned short SHADE_BLUE[LIGHT_LEVELS][32];
+
+bool SHADING_ENABLED = true;
+
+void init_shade_tables() {
+	int level, value;
+	for (level = 0; level < LIGHT_LEVELS; level++) {
+		// brightness falls linearly from 256 at level 0 to MIN_BRIGHTNESS at the last level
+		int brightness = 256 - (256 - MIN_BRIGHTNESS) * level / (LIGHT_LEVELS - 1);
+
+		for (value = 0; value < 32; value++) {
+			SHADE_RED[level][value] = ((value * brightness) >> 8) << 11;
+			SHADE_BLUE[level][value] = (value * brightness) >> 8;
+		}
+		for (value = 0; value < 64; value++) {
+			SHADE_GREEN[level][value] = ((value * brightness) >> 8) << 5;
+		}
+	}
+}
+
+int light_level(int distance, int face) {
+	int level = distance >> LIGHT_DISTANCE_SHIFT;
+	if (face == FACE_EAST || face == FACE_WEST) level += FACE_SHADE_LEVELS;
+	return (level < LIGHT_LEVELS) ? level : LIGHT_LEVELS - 1;
+}
@@ -0,0 +1,40 @@
+#ifndef SHADE_H
+#define SHADE_H
+
+#include <stdbool.h>
+
+// Distance shading. The perpendicular distance of a wall is quantized to one of LIGHT_LEVELS light levels,
+// and every level has a shade table per RGB565 channel, already shifted into place, so shading a pixel is
+// three lookups and two ORs instead of unpacking, multiplying and repacking it.
+// Faces along x (east and west) are drawn FACE_SHADE_LEVELS darker than faces along y, which is the
+// same table lookup with a bigger level.
+
+#define LIGHT_LEVELS 16
+// each light level is 1 << LIGHT_DISTANCE_SHIFT of distance (16.16 grid cells), so one grid cell
+#define LIGHT_DISTANCE_SHIFT 16
+#define FACE_SHADE_LEVELS 2
+// brightness of the darkest level, out of 256
+#define MIN_BRIGHTNESS 64
+
+// [level][channel value], level 0 is full brightness
+extern unsigned short SHADE_RED[LIGHT_LEVELS][32];
+extern unsigned short SHADE_GREEN[LIGHT_LEVELS][64];
+extern unsigned short SHADE_BLUE[LIGHT_LEVELS][32];
+
+// draw_frame only shades when this is true. true by default
+extern bool SHADING_ENABLED;
+
+// fills in the shade tables
+void init_shade_tables();
+
+// the light level of a wall at distance (16.16 grid cells) with the given wall_face
+int light_level(int distance, int face);
+
+// the light level of the floor or ceiling at distance
+#define distance_light_level(distance) \
+	(((distance) >> LIGHT_DISTANCE_SHIFT) < LIGHT_LEVELS ? ((distance) >> LIGHT_DISTANCE_SHIFT) : LIGHT_LEVELS - 1)
+
+#define shade_pixel(level, pixel) \
+	(SHADE_RED[(level)][((unsigned short)(pixel)) >> 11] | SHADE_GREEN[(level)][((pixel) >> 5) & 0x3F] | SHADE_BLUE[(level)][(pixel) & 0x1F])
+
+#endif // SHADE_H
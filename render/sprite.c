@@ -0,0 +1,201 @@
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "sprite.h"
+#include "shade.h"
+#include "palette.h"
+#include "render.h"
+#include "../backend/backend.h"
+#include "../profile/profile.h"
+
+sprite SPRITES[MAX_SPRITES];
+int SPRITE_COUNT = 0;
+short int SPRITE_TEXTURES[SPRITE_TEXTURE_COUNT][TEXTURE_SIZE][TEXTURE_SIZE];
+
+sprite_frame SPRITE_FRAME;
+
+void init_sprite_textures() {
+	int u, v;
+	for (u = 0; u < TEXTURE_SIZE; u++) {
+		for (v = 0; v < TEXTURE_SIZE; v++) {
+			// distances from the center of the bottom half, where a pickup lies, in 1/64ths of a texel squared
+			int du = 2 * u - (TEXTURE_SIZE - 1), dv = 2 * v - (TEXTURE_SIZE * 3 / 2 - 1);
+
+			// a gold coin with a darker rim, on the floor
+			int coin = du * du + dv * dv;
+			short int pickup = SPRITE_TRANSPARENT;
+			if (coin < 14 * 14) pickup = (short int)0xFEA0;
+			else if (coin < 18 * 18) pickup = (short int)0xC460;
+			SPRITE_TEXTURES[SPRITE_PICKUP][u][v] = pickup;
+
+			// a red figure: a head, a body and two legs
+			int head_v = 2 * v - 20, body = du * du / 2 + (2 * v - 56) * (2 * v - 56) / 4;
+			short int enemy = SPRITE_TRANSPARENT;
+			if (du * du + head_v * head_v < 9 * 9) enemy = (short int)0xFD75;
+			else if (v > 14 && v < 44 && body < 20 * 20) enemy = (short int)0xB8A2;
+			else if (v >= 44 && (abs(du - 9) < 5 || abs(du + 9) < 5)) enemy = (short int)0x6041;
+			SPRITE_TEXTURES[SPRITE_ENEMY][u][v] = enemy;
+		}
+	}
+}
+
+int add_sprite(int x, int y, int texture) {
+	if (SPRITE_COUNT == MAX_SPRITES) {
+		return -1;
+	}
+	SPRITES[SPRITE_COUNT].x = x;
+	SPRITES[SPRITE_COUNT].y = y;
+	SPRITES[SPRITE_COUNT].texture = texture;
+	return SPRITE_COUNT++;
+}
+
+void clear_sprites() {
+	SPRITE_COUNT = 0;
+}
+
+// fills in the depth buffer from the wall distances and builds the range maximum table on top of it
+static void build_depth_buffer(const frame_slices* slices, sprite_frame* frame) {
+	int column, level;
+	for (column = 0; column < SCREEN_SIZE_X; column++) {
+		frame->depth_max[0][column] = (slices->size[column] != INT_MAX) ? slices->distance[column] : INT_MAX;
+	}
+	for (level = 1; level <= DEPTH_LEVELS; level++) {
+		int half = 1 << (level - 1);
+		for (column = 0; column + (1 << level) <= SCREEN_SIZE_X; column++) {
+			int left = frame->depth_max[level - 1][column], right = frame->depth_max[level - 1][column + half];
+			frame->depth_max[level][column] = (left > right) ? left : right;
+		}
+	}
+}
+
+// the largest wall distance from first_column to last_column - 1, from two overlapping powers of two
+static int max_depth(const sprite_frame* frame, int first_column, int last_column) {
+	int level = 31 - __builtin_clz(last_column - first_column);
+	int left = frame->depth_max[level][first_column], right = frame->depth_max[level][last_column - (1 << level)];
+	return (left > right) ? left : right;
+}
+
+static int compare_far_to_near(const void* a, const void* b) {
+	const visible_sprite* first = a;
+	const visible_sprite* second = b;
+	return (first->distance < second->distance) - (first->distance > second->distance);
+}
+
+void prepare_sprites(int player_x, int player_y, int player_angle, const frame_slices* slices, sprite_frame* frame) {
+	frame->count = 0;
+	frame->offscreen = 0;
+	frame->occluded = 0;
+	if (SPRITE_COUNT == 0) {
+		return;
+	}
+	build_depth_buffer(slices, frame);
+
+	// the direction the player faces, and the direction to their left, in the map's y down coordinates
+	double forward_x = cosd(angle_to_degrees(player_angle)), forward_y = -sind(angle_to_degrees(player_angle));
+	double left_x = forward_y, left_y = -forward_x;
+
+	int i;
+	for (i = 0; i < SPRITE_COUNT; i++) {
+		// where the sprite is relative to the player, in grid cells
+		double dx = (SPRITES[i].x - player_x) / 64.0, dy = (SPRITES[i].y - player_y) / 64.0;
+		double depth = dx * forward_x + dy * forward_y;
+		double across = dx * left_x + dy * left_y;
+
+		int distance = depth * FIXED_ONE;
+		if (distance < SPRITE_NEAR_DISTANCE) {
+			frame->offscreen++;
+			continue;
+		}
+
+		// the screen column of the sprite's center, the same way the rays are spread across the screen: one
+		// binary angle per column, from HALF_FOV_UNITS to the left of the player angle. It is as wide as it is tall
+		int center = floor(HALF_FOV_UNITS - atan2(across, depth) * 180 / M_PI / RAY_ANGLE_INC + 0.5);
+		int size = projected_slice_size(distance);
+		int left = center - size / 2, right = left + size;
+		int first_column = (left > 0) ? left : 0;
+		int last_column = (right < SCREEN_SIZE_X) ? right : SCREEN_SIZE_X;
+		if (first_column >= last_column) {
+			frame->offscreen++;
+			continue;
+		}
+
+		// the sprite is only drawn where it is nearer than the wall, if the furthest wall it covers is nearer
+		// than it the whole sprite is hidden
+		if (max_depth(frame, first_column, last_column) <= distance) {
+			frame->occluded++;
+			continue;
+		}
+
+		visible_sprite* visible = &frame->sprites[frame->count++];
+		visible->distance = distance;
+		visible->first_column = first_column;
+		visible->last_column = last_column;
+		visible->left = left;
+		visible->width = size;
+		visible->texture = SPRITES[i].texture;
+	}
+
+	qsort(frame->sprites, frame->count, sizeof(visible_sprite), compare_far_to_near);
+}
+
+void draw_sprite_columns(render_target* target, int first_column, int last_column) {
+	const sprite_frame* frame = target->sprites;
+	PROFILE_ONLY(int total_pixel_writes = 0);
+	int i;
+	for (i = 0; i < frame->count; i++) {
+		const visible_sprite* visible = &frame->sprites[i];
+		int first = (visible->first_column > first_column) ? visible->first_column : first_column;
+		int last = (visible->last_column < last_column) ? visible->last_column : last_column;
+		if (first >= last) {
+			continue;
+		}
+
+		// a grid cell tall and standing on the floor, like a wall at the same distance
+		int size = projected_slice_size(visible->distance);
+		int top = (SCREEN_SIZE_Y - size) / 2;
+		int first_row = (top > 0) ? top : 0;
+		int last_row = (top + size < SCREEN_SIZE_Y) ? top + size : SCREEN_SIZE_Y;
+		int texel_step = (TEXTURE_SIZE << 16) / size;
+		int level = SHADING_ENABLED ? distance_light_level(visible->distance) : 0;
+
+		int column;
+		for (column = first; column < last; column++) {
+			if (visible->distance >= frame->depth_max[0][column]) {
+				continue;
+			}
+			int texture_u = (column - visible->left) * TEXTURE_SIZE / visible->width;
+			int texel_v = (first_row - top) * texel_step;
+
+			int row, pixel_writes = 0;
+			if (PALETTE_ENABLED) {
+				const unsigned char* texels = SPRITE_TEXTURES_INDEXED[visible->texture][texture_u];
+				short int* pixel = target->frame_buffer + first_row * FRAME_BUFFER_STRIDE + column;
+				for (row = first_row; row < last_row; row++, pixel += FRAME_BUFFER_STRIDE) {
+					unsigned char texel = texels[texel_v >> 16];
+					texel_v += texel_step;
+					if (texel != PALETTE_TRANSPARENT) {
+						*pixel = SHADE_PALETTE[level][texel];
+						pixel_writes++;
+					}
+				}
+			} else {
+				const short int* texels = SPRITE_TEXTURES[visible->texture][texture_u];
+				short int* pixel = target->frame_buffer + first_row * FRAME_BUFFER_STRIDE + column;
+				for (row = first_row; row < last_row; row++, pixel += FRAME_BUFFER_STRIDE) {
+					short int texel = texels[texel_v >> 16];
+					texel_v += texel_step;
+					if (texel != SPRITE_TRANSPARENT) {
+						*pixel = (level != 0) ? shade_pixel(level, texel) : texel;
+						pixel_writes++;
+					}
+				}
+			}
+			target->column_pixel_writes[column] += pixel_writes;
+			if (target->drawn != NULL && pixel_writes > 0) {
+				target->drawn->columns[column].sprites = true;
+			}
+			PROFILE_ONLY(total_pixel_writes += pixel_writes);
+		}
+	}
+	PROFILE_COUNT(COUNTER_PIXELS, total_pixel_writes);
+}
@@ -0,0 +1,88 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include "../raycast-core/raycast.h"
+#include "texture.h"
+
+// Objects placed in the map, such as pickups and enemies, drawn as billboards that always face the player.
+// A sprite stands on the floor as tall as a wall block and is drawn square on screen, centered on its position,
+// from one of SPRITE_TEXTURE_COUNT textures, which are transparent wherever they are SPRITE_TRANSPARENT.
+// Every sprite is drawn at one perpendicular distance, so the wall distances of the ray cast are its depth
+// buffer: a sprite column is only drawn where the sprite is nearer than that column's wall. Before any
+// drawing, prepare_sprites projects the sprites, drops the ones off screen and the ones behind the walls in every
+// column they cover (one range maximum query of the depth buffer each), and sorts the rest far to near, so the
+// nearer sprites are drawn over the further ones. Drawing then only costs as much as the sprites that can be seen.
+
+#define MAX_SPRITES 1024
+// magenta
+#define SPRITE_TRANSPARENT ((short int)0xF81F)
+// sprites nearer than this (16.16 grid cells) are behind the player or about to be walked through
+#define SPRITE_NEAR_DISTANCE (FIXED_ONE / 4)
+
+// the depth buffer's range maximum table has a level per power of two up to SCREEN_SIZE_X, 1 << DEPTH_LEVELS
+#define DEPTH_LEVELS 8
+
+typedef enum sprite_texture {
+	SPRITE_PICKUP,
+	SPRITE_ENEMY,
+	SPRITE_TEXTURE_COUNT
+} sprite_texture;
+
+typedef struct sprite {
+	// the center of the sprite on the floor, unit coordinates
+	int x;
+	int y;
+	unsigned char texture;
+} sprite;
+
+// a sprite on screen this frame, see prepare_sprites
+typedef struct visible_sprite {
+	// perpendicular distance, 16.16 grid cells like frame_slices.distance
+	int distance;
+	// the screen columns it covers, and where its left edge is and how wide (and tall) it is before clipping to the screen
+	int first_column;
+	int last_column;
+	int left;
+	int width;
+	unsigned char texture;
+} visible_sprite;
+
+// the sprites prepare_sprites found to draw this frame, far to near, and what it dropped
+typedef struct sprite_frame {
+	visible_sprite sprites[MAX_SPRITES];
+	int count;
+	int offscreen;
+	int occluded;
+	// depth_max[0] is the depth buffer, the wall distance of every column, INT_MAX where there is no wall.
+	// depth_max[level][column] is the largest of them from column to column + (1 << level) - 1
+	int depth_max[DEPTH_LEVELS + 1][SCREEN_SIZE_X];
+} sprite_frame;
+
+extern sprite SPRITES[MAX_SPRITES];
+extern int SPRITE_COUNT;
+extern short int SPRITE_TEXTURES[SPRITE_TEXTURE_COUNT][TEXTURE_SIZE][TEXTURE_SIZE];
+
+// the sprites draw_frame found to draw in the last frame
+extern sprite_frame SPRITE_FRAME;
+
+// draws the sprite textures, column major like the wall textures
+void init_sprite_textures();
+
+// places a sprite at (x, y) in unit coordinates. Returns its index, or -1 if there are MAX_SPRITES already
+int add_sprite(int x, int y, int texture);
+
+// removes every sprite
+void clear_sprites();
+
+// projects SPRITES for the player at (player_x, player_y) facing player_angle, drops the ones off screen or hidden
+// behind the walls of slices, and sorts the rest into frame far to near
+void prepare_sprites(int player_x, int player_y, int player_angle, const frame_slices* slices, sprite_frame* frame);
+
+// see render.h, which includes this file
+struct render_target;
+
+// draws the columns from first_column to last_column - 1 of the sprites prepared in target->sprites over its walls.
+// Adds the pixels drawn to its column_pixel_writes
+void draw_sprite_columns(struct render_target* target, int first_column, int last_column);
+
+#endif // SPRITE_H
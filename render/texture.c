@@ -0,0 +1,92 @@
+#include <stdbool.h>
+
+#include "texture.h"
+
+// texture file header size, in texels
+#define TEXTURE_FILE_HEADER 2
+
+short int WALL_TEXTURES[MAX_WALL_TEXTURES][TEXTURE_SIZE][TEXTURE_SIZE];
+short int WALL_TEXTURE_MIPS[MAX_WALL_TEXTURES][TEXTURE_MIP_TEXELS + TEXTURE_MIP_PADDING];
+int WALL_TEXTURE_COUNT = 0;
+bool MIPMAPS_ENABLED = true;
+
+short int FLOOR_TEXTURE[TEXTURE_SIZE][TEXTURE_SIZE];
+short int CEILING_TEXTURE[TEXTURE_SIZE][TEXTURE_SIZE];
+
+// included in brick_image.s. Modify the path there to the texture (.bin) file as required
+extern short int BRICK_IMAGE[];
+
+void build_mip_chain(int slot);
+
+int load_wall_texture(const void* texture_file) {
+	if (WALL_TEXTURE_COUNT == MAX_WALL_TEXTURES) {
+		return -1;
+	}
+	const short int* texels = (const short int*)texture_file + TEXTURE_FILE_HEADER;
+
+	// transpose from row major
+	int u, v;
+	for (u = 0; u < TEXTURE_SIZE; u++) {
+		for (v = 0; v < TEXTURE_SIZE; v++) {
+			WALL_TEXTURES[WALL_TEXTURE_COUNT][u][v] = texels[v * TEXTURE_SIZE + u];
+		}
+	}
+	build_mip_chain(WALL_TEXTURE_COUNT);
+	return WALL_TEXTURE_COUNT++;
+}
+
+// averages each 2 x 2 block of texels of a level, a channel at a time, into a texel of the next one
+void build_mip_chain(int slot) {
+	const short int* above = &WALL_TEXTURES[slot][0][0];
+	int level, u, v;
+	for (level = 1; level < MIP_LEVELS; level++) {
+		short int* texels = WALL_TEXTURE_MIPS[slot] + mip_offset(level);
+		int size = TEXTURE_SIZE >> level;
+		for (u = 0; u < size; u++) {
+			for (v = 0; v < size; v++) {
+				// the four texels, from columns 2u and 2u + 1 of the level above
+				unsigned short quad[4] = { above[(2 * u) * 2 * size + 2 * v], above[(2 * u) * 2 * size + 2 * v + 1],
+					above[(2 * u + 1) * 2 * size + 2 * v], above[(2 * u + 1) * 2 * size + 2 * v + 1] };
+				int red = 0, green = 0, blue = 0, i;
+				for (i = 0; i < 4; i++) {
+					red += quad[i] >> 11;
+					green += (quad[i] >> 5) & 0x3F;
+					blue += quad[i] & 0x1F;
+				}
+				texels[u * size + v] = (short int)(((red + 2) / 4) << 11 | ((green + 2) / 4) << 5 | ((blue + 2) / 4));
+			}
+		}
+		above = texels;
+	}
+}
+
+int wall_mip_level(int wall_size) {
+	int level = 0;
+	if (MIPMAPS_ENABLED) {
+		while (level < MIP_LEVELS - 1 && (TEXTURE_SIZE >> (level + 1)) >= wall_size) level++;
+	}
+	return level;
+}
+
+const short int* wall_texel_column(int slot, int level, int u) {
+	return (level == 0) ? WALL_TEXTURES[slot][u] : WALL_TEXTURE_MIPS[slot] + mip_column_offset(level, u);
+}
+
+void init_wall_textures() {
+	WALL_TEXTURE_COUNT = 0;
+	load_wall_texture(BRICK_IMAGE);
+}
+
+void init_floor_textures() {
+	int u, v;
+	for (u = 0; u < TEXTURE_SIZE; u++) {
+		for (v = 0; v < TEXTURE_SIZE; v++) {
+			// four tiles per cell, alternating shades, with a darker line between them
+			bool edge = (u % (TEXTURE_SIZE / 2)) == 0 || (v % (TEXTURE_SIZE / 2)) == 0;
+			bool dark_tile = ((u ^ v) & (TEXTURE_SIZE / 2)) != 0;
+			FLOOR_TEXTURE[u][v] = edge ? 0x6B4D : (dark_tile ? 0x8C51 : 0x9492);
+
+			CEILING_TEXTURE[u][v] = (u == 0 || v == 0) ? 0xDEFB : 0xFFFF;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef TEXTURE_H
+#define TEXTURE_H
+
+#include <stdbool.h>
+
+// Wall textures are TEXTURE_SIZE x TEXTURE_SIZE RGB565, stored column major: [texture][u][v], so drawing a
+// wall column reads one contiguous run of TEXTURE_SIZE texels.
+// Texture files (.bin, e.g. textures/brick.bin) are a 4 byte header followed by the texels row major,
+// they are transposed once by load_wall_texture.
+
+#define TEXTURE_SHIFT 6
+#define TEXTURE_SIZE (1 << TEXTURE_SHIFT)
+#define MAX_WALL_TEXTURES 8
+
+// Wall textures have a mip chain: level 1 is TEXTURE_SIZE / 2 texels a side, each texel the average of 2 x 2 texels
+// of the level above, down to level TEXTURE_SHIFT at 1 x 1. A wall slice shorter than the texture draws from the
+// smallest level that still has a texel per pixel (see wall_mip_level), so a far wall reads a short run of texels
+// that are the average of the ones it steps over, instead of picking a few texels out of the whole column.
+// The levels of a texture follow each other, column major like the full size texture: level l starts at
+// mip_offset(l), and its column u at mip_column_offset(l, u).
+#define MIP_LEVELS (TEXTURE_SHIFT + 1)
+// the texels of levels 1 to TEXTURE_SHIFT
+#define TEXTURE_MIP_TEXELS ((TEXTURE_SIZE * TEXTURE_SIZE - 1) / 3)
+// the SIMD raster kernels read texels in groups of 8, up to 7 past the last one of a column
+#define TEXTURE_MIP_PADDING 8
+#define mip_offset(level) ((TEXTURE_SIZE * TEXTURE_SIZE - ((TEXTURE_SIZE * TEXTURE_SIZE) >> (2 * ((level) - 1)))) / 3)
+#define mip_column_offset(level, u) (mip_offset(level) + ((u) >> (level)) * (TEXTURE_SIZE >> (level)))
+
+extern short int WALL_TEXTURES[MAX_WALL_TEXTURES][TEXTURE_SIZE][TEXTURE_SIZE];
+// levels 1 to TEXTURE_SHIFT of each wall texture
+extern short int WALL_TEXTURE_MIPS[MAX_WALL_TEXTURES][TEXTURE_MIP_TEXELS + TEXTURE_MIP_PADDING];
+
+// draw_frame draws walls from the mip chains when this is true. true by default
+extern bool MIPMAPS_ENABLED;
+
+// every floor and ceiling cell uses these, made by init_floor_textures
+extern short int FLOOR_TEXTURE[TEXTURE_SIZE][TEXTURE_SIZE];
+extern short int CEILING_TEXTURE[TEXTURE_SIZE][TEXTURE_SIZE];
+
+// number of textures loaded into WALL_TEXTURES
+extern int WALL_TEXTURE_COUNT;
+
+// copies a texture file linked into the program (see brick_image.s) into the next free slot of WALL_TEXTURES,
+// and builds its mip chain. Returns the slot, or -1 if they're all used
+int load_wall_texture(const void* texture_file);
+
+// the mip level to draw a wall slice wall_size pixels tall (before it is limited to the screen) from, 0 for the full
+// size texture. Always 0 when MIPMAPS_ENABLED is false
+int wall_mip_level(int wall_size);
+
+// the texel column u (0 - TEXTURE_SIZE - 1) of the wall texture in slot at mip level, TEXTURE_SIZE >> level texels
+const short int* wall_texel_column(int slot, int level, int u);
+
+// loads the textures linked into the program. Tile type 1 walls use the first one
+void init_wall_textures();
+
+// draws the floor and ceiling textures: grey tiles and a white ceiling with faint panel lines, the colours
+// the floor and ceiling used to be filled with
+void init_floor_textures();
+
+// the slot of the texture for walls of tile type (1 - 255), textures repeat when there are more tile types than textures
+#define wall_texture_slot(tile_type) (((tile_type) - 1) % WALL_TEXTURE_COUNT)
+#define wall_texture_for(tile_type) (WALL_TEXTURES[wall_texture_slot(tile_type)])
+
+#endif // TEXTURE_H